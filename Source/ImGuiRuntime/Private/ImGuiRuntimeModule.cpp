@@ -30,6 +30,11 @@ void ImGuiAssertHook(bool bCondition, const char* Expression, const char* File,
 #include "ImGuiLib.cpp"
 #endif
 
+namespace ImGuiUtils
+{
+	extern void InitializeKeyTranslationTable();
+}
+
 #ifdef IMGUI_ALLOW_MENUBAR_EXTENSION
 namespace ImGuiUtils
 {
@@ -54,6 +59,8 @@ private:
 		IMGUI_CHECKVERSION();
 		IMGUI_SETUP_DEFAULT_ALLOCATOR();
 
+		ImGuiUtils::InitializeKeyTranslationTable();
+
 #ifdef IMGUI_ALLOW_MENUBAR_EXTENSION
 		ImGuiUtils::RegisterMenuExtensions();
 #endif
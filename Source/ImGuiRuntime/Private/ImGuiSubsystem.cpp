@@ -9,7 +9,12 @@
 #include "RenderingThread.h"
 #include "Misc/EngineVersion.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Utils/ImGuiFontData.h"
+#include "Utils/ImGuiFileWriter.h"
+#include "Utils/ImGuiGlyphBaker.h"
 #include "Utils/ImGuiImageCache.h"
+#include "Utils/ImGuiSdfFontLoader.h"
+#include "HAL/LowLevelMemTracker.h"
 #include "Framework/Application/SlateApplication.h"
 
 #if WITH_ENGINE
@@ -35,6 +40,25 @@ static TAutoConsoleVariable<bool> CVarEnableFreeType(
 	ECVF_ReadOnly);
 #endif
 
+static TAutoConsoleVariable<bool> CVarLazyInitialization(
+	TEXT("imgui.LazyInitialization"),
+	true,
+	TEXT("Defer loading fonts and building the font atlas until the first ImGui widget is created."),
+	ECVF_ReadOnly);
+
+LLM_DECLARE_TAG(ImGui_FontAtlas);
+
+static const FString& GetDefaultFontFilepath()
+{
+	static const FString FontFilepath = FPaths::EngineContentDir() / TEXT("Slate/Fonts/Roboto-Regular.ttf");
+	return FontFilepath;
+}
+
+static FString GetGlyphCacheFilepath(const FAnsiString& IniDirectoryPath)
+{
+	return FPaths::Combine(UTF8_TO_TCHAR(*IniDirectoryPath), TEXT("FontGlyphCache.bin"));
+}
+
 /*--------------------------------------------------------------------------------------------------------------------------*/
 
 const FSlateShaderResourceProxy* FImGuiTextureResource::GetSlateShaderResourceProxy() const
@@ -105,8 +129,23 @@ UImGuiSubsystem* UImGuiSubsystem::Get()
 	return SubsystemInstance.Get();
 }
 
+UImGuiSubsystem* UImGuiSubsystem::Get(FOutputDevice& Ar)
+{
+	UImGuiSubsystem* ImGuiSubsystem = Get();
+	if (!ImGuiSubsystem)
+	{
+		Ar.Log(TEXT("ImGui subsystem is not initialized."));
+	}
+	return ImGuiSubsystem;
+}
+
 void UImGuiSubsystem::Initialize()
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UImGuiSubsystem::Initialize);
+	const double StartTime = FPlatformTime::Seconds();
+
+	m_FileWriter = MakeUnique<ImGuiUtils::FImGuiFileWriter>();
+
 	// setup config file for storing widget specific data
 	{
 		m_SaveDataConfigFile = GConfig->Find(GetSaveDataConfigFilepath());
@@ -128,6 +167,8 @@ void UImGuiSubsystem::Initialize()
 		IFileManager::Get().MakeDirectory(UTF8_TO_TCHAR(*m_IniDirectoryPath), true);
 	}
 
+	FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::FontAtlas };
+
 	// NOTE: Add reference to make sure ImGuiContext cannot release the font atlas
 	m_SharedFontAtlas = MakeShared<ImFontAtlas, ESPMode::NotThreadSafe>();
 	m_SharedFontAtlas->TexMinWidth  = 512;
@@ -139,9 +180,43 @@ void UImGuiSubsystem::Initialize()
 		m_SharedFontAtlas->SetFontLoader(ImGuiFreeType::GetFontLoader());
 	}
 #endif
-	if (!m_SharedFontAtlas->AddFontFromFileTTF(TCHAR_TO_ANSI(*(FPaths::EngineContentDir() / TEXT("Slate/Fonts/Roboto-Regular.ttf"))), 15.f))
+
+	// spreads glyph rasterization for new font sizes over multiple frames
 	{
-		m_SharedFontAtlas->AddFontDefaultBitmap();
+		// same selection as ImFontAtlasBuildInit
+		const ImFontLoader* FontLoader = m_SharedFontAtlas->FontLoader;
+		if (!FontLoader)
+		{
+#if WITH_FREETYPE
+			FontLoader = ImGuiFreeType::GetFontLoader();
+#else
+			FontLoader = ImFontAtlasGetFontLoaderForStbTruetype();
+#endif
+		}
+		m_GlyphBaker = MakeUnique<ImGuiUtils::FImGuiGlyphBaker>(m_SharedFontAtlas.Get(), FontLoader);
+		m_SharedFontAtlas->SetFontLoader(m_GlyphBaker->GetFontLoader());
+	}
+
+	if (CVarEnableGlyphCache.GetValueOnGameThread())
+	{
+		m_GlyphCache = MakeUnique<ImGuiUtils::FImGuiGlyphCache>();
+		m_GlyphCacheLoadTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[GlyphCache = m_GlyphCache.Get(), FilePath = GetGlyphCacheFilepath(m_IniDirectoryPath)]()
+			{
+				GlyphCache->Load(FilePath);
+			}, LowLevelTasks::ETaskPriority::BackgroundNormal);
+	}
+
+	// prefetch the default font, sessions that never open a widget don't pay for the atlas
+	m_DefaultFontDataTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[]()
+		{
+			return ImGuiUtils::FImGuiFontData::Load(GetDefaultFontFilepath(), /*bPrefetch=*/true);
+		}, LowLevelTasks::ETaskPriority::BackgroundNormal);
+
+	if (!CVarLazyInitialization.GetValueOnGameThread())
+	{
+		EnsureFontsLoaded();
 	}
 
 #ifdef WITH_NET_IMGUI
@@ -161,17 +236,88 @@ void UImGuiSubsystem::Initialize()
 
 	FCoreDelegates::OnBeginFrame.AddRaw(this, &UImGuiSubsystem::BeginImGuiFrame);
 	FCoreDelegates::OnEndFrame.AddRaw(this, &UImGuiSubsystem::EndImGuiFrame);
+
+	m_InitializeTime = FPlatformTime::Seconds() - StartTime;
+}
+
+void UImGuiSubsystem::EnsureFontsLoaded()
+{
+	if (m_bFontsLoaded)
+	{
+		return;
+	}
+	m_bFontsLoaded = true;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UImGuiSubsystem::EnsureFontsLoaded);
+	const double StartTime = FPlatformTime::Seconds();
+
+	FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::FontAtlas };
+
+	// usually done by now, only waits when a widget is created right after startup
+	TUniquePtr<ImGuiUtils::FImGuiFontData> DefaultFontData = MoveTemp(m_DefaultFontDataTask.GetResult());
+	m_DefaultFontDataTask = {};
+
+	m_GlyphCacheLoadTask.Wait();
+	m_GlyphBaker->SetGlyphCache(m_GlyphCache.Get());
+
+	if (AddFontData(MoveTemp(DefaultFontData), 15.f, nullptr, nullptr))
+	{
+#if WITH_ENGINE && IMGUI_ALLOW_LOCAL_DRAWING
+		// only the engine drawer has the SDF pixel shader, other paths would draw the raw distances
+		if (CVarSdfFonts.GetValueOnGameThread())
+		{
+			AddSdfFont(*m_FontData.Last(), 15.f);
+		}
+#endif
+	}
+	else
+	{
+		m_SharedFontAtlas->AddFontDefaultBitmap();
+	}
+
+	// build the atlas right away, widgets start their frame before the next subsystem frame
+	CommitSharedFontAtlasChanges();
+
+	m_FontLoadTime = FPlatformTime::Seconds() - StartTime;
 }
 
 void UImGuiSubsystem::Deinitialize()
 {
+	// keep glyphs rasterized this session for the next one
+	m_GlyphCacheLoadTask.Wait();
+	if (m_GlyphCache)
+	{
+		TArray<uint8> GlyphCacheData;
+		if (m_GlyphCache->Save(GlyphCacheData))
+		{
+			QueueFileWrite(GetGlyphCacheFilepath(m_IniDirectoryPath), MoveTemp(GlyphCacheData));
+		}
+	}
+
+	// write whatever is still queued, writes queued after this (widgets destroyed later) are flushed by the writer destructor
+	m_FileWriter->Flush();
+
 #ifdef WITH_NET_IMGUI
 	m_ImageCache.Reset();
 #endif
 
 	// ensure all widgets have released the shared font reference (all slate widgets should be destroyed at this point)
+	// cached text references fonts of the atlases
+	ImGuiTextCache::Reset();
+
 	check(m_SharedFontAtlas->RefCount == 1);
 	m_SharedFontAtlas = nullptr;
+	check(!m_SdfFontAtlas || m_SdfFontAtlas->RefCount == 1);
+	m_SdfFontAtlas = nullptr;
+	m_SdfFont = nullptr;
+	// atlas shuts down the font loader on destruction
+	m_GlyphBaker.Reset();
+	m_GlyphCache.Reset();
+
+	// atlas is gone, font data is no longer referenced
+	m_DefaultFontDataTask.Wait();
+	m_DefaultFontDataTask = {};
+	m_FontData.Reset();
 
 	m_SharedFontAtlasTextures.Reset();
 
@@ -179,6 +325,109 @@ void UImGuiSubsystem::Deinitialize()
 	FCoreDelegates::OnEndFrame.RemoveAll(this);
 }
 
+ImFont* UImGuiSubsystem::AddFontFromFile(const FString& FilePath, float SizePixels, const ImFontConfig* FontConfig, const ImWchar* GlyphRanges)
+{
+	// keeps the default font first
+	EnsureFontsLoaded();
+
+	FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::FontAtlas };
+	return AddFontData(ImGuiUtils::FImGuiFontData::Load(FilePath), SizePixels, FontConfig, GlyphRanges);
+}
+
+ImFont* UImGuiSubsystem::AddFontData(TUniquePtr<ImGuiUtils::FImGuiFontData> FontData, float SizePixels, const ImFontConfig* FontConfig, const ImWchar* GlyphRanges)
+{
+	if (!FontData)
+	{
+		return nullptr;
+	}
+
+	ImFontConfig SourceFontConfig = FontConfig ? *FontConfig : ImFontConfig();
+	// glyphs are rasterized straight from the file data, which stays alive (and mapped) for the lifetime of the atlas
+	SourceFontConfig.FontDataOwnedByAtlas = false;
+
+	ImFont* Font = m_SharedFontAtlas->AddFontFromMemoryTTF(FontData->GetData(), FontData->GetSize(), SizePixels, &SourceFontConfig, GlyphRanges);
+	if (Font)
+	{
+		m_FontData.Add(MoveTemp(FontData));
+	}
+	return Font;
+}
+
+void UImGuiSubsystem::AddSdfFont(const ImGuiUtils::FImGuiFontData& FontData, float SizePixels)
+{
+	// separate atlas, the pixel shader can't tell SDF glyphs apart from regular glyphs/images in the same texture
+	m_SdfFontAtlas = MakeShared<ImFontAtlas, ESPMode::NotThreadSafe>();
+	m_SdfFontAtlas->TexMinWidth  = 512;
+	m_SdfFontAtlas->TexMinHeight = 512;
+	m_SdfFontAtlas->RefCount = 1;
+	// only text is drawn from this atlas, while it is the current font lines are tessellated (baked lines would go through the SDF shader)
+	// and no software cursor can be drawn (widgets use the hardware cursor)
+	m_SdfFontAtlas->Flags |= ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_NoMouseCursors;
+	m_SdfFontAtlas->SetFontLoader(ImGuiUtils::FImGuiSdfFontLoader::Get());
+
+	ImFontConfig FontConfig;
+	FontConfig.FontDataOwnedByAtlas = false;
+	m_SdfFont = m_SdfFontAtlas->AddFontFromMemoryTTF(FontData.GetData(), FontData.GetSize(), SizePixels, &FontConfig);
+	if (!m_SdfFont)
+	{
+		m_SdfFontAtlas = nullptr;
+		return;
+	}
+
+	// every font size (zoom, DPI) scales this bake instead of adding a new one
+	m_SdfFont->GetFontBaked((float)FMath::Max(CVarSdfFontBakeSize.GetValueOnGameThread(), 8), 1.f);
+	m_SdfFont->Flags |= ImFontFlags_LockBakedSizes;
+}
+
+static FAutoConsoleCommandWithOutputDevice CmdReportFontData(
+	TEXT("imgui.Fonts.Report"),
+	TEXT("Lists font files referenced by the shared ImGui font atlas and whether they are memory mapped or copied to the heap."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+		{
+			if (UImGuiSubsystem* ImGuiSubsystem = UImGuiSubsystem::Get(Ar))
+			{
+				ImGuiSubsystem->ReportFontData(Ar);
+			}
+		}));
+
+void UImGuiSubsystem::ReportFontData(FOutputDevice& Ar) const
+{
+	int64 MappedBytes = 0;
+	int64 HeapBytes = 0;
+	for (const TUniquePtr<ImGuiUtils::FImGuiFontData>& FontData : m_FontData)
+	{
+		(FontData->IsMapped() ? MappedBytes : HeapBytes) += FontData->GetSize();
+		Ar.Logf(TEXT("  %-6s %8.1f KB  %s"), FontData->IsMapped() ? TEXT("mapped") : TEXT("heap"), FontData->GetSize() / 1024.0, *FontData->GetFilePath());
+	}
+	// NOTE: mapped pages are shared b/w processes and can be evicted by the OS, only heap bytes are resident for sure
+	Ar.Logf(TEXT("ImGui font data: %d files, %.1f KB mapped, %.1f KB heap"), m_FontData.Num(), MappedBytes / 1024.0, HeapBytes / 1024.0);
+}
+
+static FAutoConsoleCommandWithOutputDevice CmdReportStartupTimings(
+	TEXT("imgui.Startup.Report"),
+	TEXT("Reports time spent initializing the ImGui subsystem during engine startup and loading fonts."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+		{
+			if (UImGuiSubsystem* ImGuiSubsystem = UImGuiSubsystem::Get(Ar))
+			{
+				ImGuiSubsystem->ReportStartupTimings(Ar);
+			}
+		}));
+
+void UImGuiSubsystem::ReportStartupTimings(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("ImGui startup (lazy initialization %s):"), CVarLazyInitialization.GetValueOnGameThread() ? TEXT("on") : TEXT("off"));
+	Ar.Logf(TEXT("  subsystem initialize : %.3f ms"), m_InitializeTime * 1000.0);
+	if (m_bFontsLoaded)
+	{
+		Ar.Logf(TEXT("  font load            : %.3f ms"), m_FontLoadTime * 1000.0);
+	}
+	else
+	{
+		Ar.Log(TEXT("  font load            : deferred (no widget created yet)"));
+	}
+}
+
 bool UImGuiSubsystem::ShouldEnableImGui()
 {
 	return !IsRunningCommandlet();
@@ -223,12 +472,29 @@ bool UImGuiSubsystem::SaveConfigToDisk() const
 {
 	if (m_SaveDataConfigFile)
 	{
-		GConfig->Flush(false, GetSaveDataConfigFilepath());
+		// serialize here, the file is written on a background task
+		FString ConfigText;
+		if (m_SaveDataConfigFile->WriteToString(ConfigText, GetSaveDataConfigFilepath()))
+		{
+			FTCHARToUTF8 ConfigTextUtf8(*ConfigText);
+			QueueFileWrite(GetSaveDataConfigFilepath(), TArray<uint8>((const uint8*)ConfigTextUtf8.Get(), ConfigTextUtf8.Length()));
+			m_SaveDataConfigFile->Dirty = false;
+		}
 		return true;
 	}
 	return false;
 }
 
+void UImGuiSubsystem::QueueFileWrite(const FString& FilePath, TArray<uint8>&& Contents) const
+{
+	m_FileWriter->QueueWrite(FilePath, MoveTemp(Contents));
+}
+
+bool UImGuiSubsystem::GetPendingFileContents(const FString& FilePath, TArray<uint8>& OutContents) const
+{
+	return m_FileWriter->GetPendingContents(FilePath, OutContents);
+}
+
 #ifdef IMGUI_ALLOW_MENUBAR_EXTENSION
 void UImGuiSubsystem::RegisterMainMenuWidget(
 	const UWorld* World, const char* WidgetPath, const char* WidgetToolTip, const FSlateBrush* WidgetIcon,
@@ -272,8 +538,21 @@ void UImGuiSubsystem::BeginImGuiFrame()
 	m_OneFrameResources.Reset();
 	m_OneFrameSlateBrushes.Reset();
 
-	// queue font updates
-	ImFontAtlasUpdateNewFrame(m_SharedFontAtlas.Get(), ++m_FontAtlasBuilderFrameCount, true);
+	m_FileWriter->Tick();
+
+	// queue font updates (an empty atlas would build the ImGui default font)
+	if (m_bFontsLoaded)
+	{
+		FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::FontAtlas };
+		ImFontAtlasUpdateNewFrame(m_SharedFontAtlas.Get(), ++m_FontAtlasBuilderFrameCount, true);
+		if (m_SdfFontAtlas)
+		{
+			ImFontAtlasUpdateNewFrame(m_SdfFontAtlas.Get(), m_FontAtlasBuilderFrameCount, true);
+		}
+
+		// glyphs widgets couldn't bake last frame
+		m_GlyphBaker->BakeDeferredGlyphs();
+	}
 
 	// register all font altases
 	for (const FImGuiFontTextureEntry& TextureEntry : m_SharedFontAtlasTextures)
@@ -292,7 +571,8 @@ void UImGuiSubsystem::BeginImGuiFrame()
 	GCaptureNextGpuFrames = FMath::Max(0, GCaptureNextGpuFrames - 1);
 
 #ifdef WITH_NET_IMGUI
-	if (m_ImageCache)
+	// image cache reads the atlas builder state, which doesn't exist until fonts are loaded
+	if (m_ImageCache && m_bFontsLoaded)
 	{
 		m_ImageCache->OnBeginFrame();
 	}
@@ -313,11 +593,24 @@ ImTextureRef UImGuiSubsystem::GetSharedFontTextureID() const
 
 void UImGuiSubsystem::CommitSharedFontAtlasChanges()
 {
+	if (!m_bFontsLoaded)
+	{
+		// also commits the changes
+		EnsureFontsLoaded();
+		return;
+	}
+
+	FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::FontAtlas };
 	ImFontAtlasUpdateNewFrame(m_SharedFontAtlas.Get(), ++m_FontAtlasBuilderFrameCount, true);
+	if (m_SdfFontAtlas)
+	{
+		ImFontAtlasUpdateNewFrame(m_SdfFontAtlas.Get(), m_FontAtlasBuilderFrameCount, true);
+	}
 }
 
 int32 UImGuiSubsystem::AllocateFontAtlasTexture(int32 SizeX, int32 SizeY)
 {
+	LLM_SCOPE_BYTAG(ImGui_FontAtlas);
 	static const FName FontTextureName = TEXT("ImGui_SharedFontTexture");
 
 	for (int32 TextureIndex = 0; TextureIndex < m_SharedFontAtlasTextures.Num(); ++TextureIndex)
@@ -367,6 +660,9 @@ void UImGuiSubsystem::ReleaseFontAtlasTexture(int32 Index)
 
 void UImGuiSubsystem::UpdateFontAtlasTextures(ImTextureData** Textures, int32 TextureCount)
 {
+	LLM_SCOPE_BYTAG(ImGui_FontAtlas);
+	FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::FontAtlas };
+
 	for (int32 TextureIndex = 0; TextureIndex < TextureCount; ++TextureIndex)
 	{
 		ImTextureData* TexData = Textures[TextureIndex];
@@ -388,6 +684,7 @@ void UImGuiSubsystem::UpdateFontAtlasTexture(ImTextureData* TexData)
 		{
 			check(TexData->BytesPerPixel == GPixelFormats[PF_R8G8B8A8].BlockBytes);
 			TexData->SetTexID(AllocateFontAtlasTexture(FontAtlasWidth, FontAtlasHeight));
+			m_SharedFontAtlasTextures[TexData->GetTexID()].bIsSdf = m_SdfFontAtlas && m_SdfFontAtlas->TexList.contains(TexData);
 		}
 
 #if IMGUI_ALLOW_LOCAL_DRAWING
@@ -436,7 +733,7 @@ void UImGuiSubsystem::UpdateFontAtlasTexture(ImTextureData* TexData)
 	else if (TexData->Status == ImTextureStatus_WantDestroy && TexData->UnusedFrames > 1)
 	{
 		// latest shared font texture data should never be destroyed!
-		check(TexData != m_SharedFontAtlas->TexData);
+		check(TexData != m_SharedFontAtlas->TexData && (!m_SdfFontAtlas || TexData != m_SdfFontAtlas->TexData));
 
 		ReleaseFontAtlasTexture(TexData->GetTexID());
 
@@ -3,15 +3,25 @@
 #include "SImGuiWidgets.h"
 
 #include "Misc/App.h"
+#include "Async/Async.h"
 #include "Widgets/SWindow.h"
 #include "Application/ThrottleManager.h"
 #include "Framework/Application/SlateApplication.h"
 
 #include "ImGuiSubsystem.h"
 #include "Utils/ImGuiInputs.inl"
+#include "Utils/ImGuiDrawListTrim.inl"
 #include "Utils/ImGuiDrawing.inl"
+#include "Utils/ImGuiContextPool.inl"
 #include "Utils/ImGuiViewport.inl"
 #include "Utils/ImGuiPlatform.inl"
+#include "Utils/ImGuiTrace.inl"
+#include "Utils/ImGuiContextPool.h"
+
+static TAutoConsoleVariable<float> CVarWidgetFrameBudget(
+	TEXT("imgui.FrameBudget.WidgetMs"),
+	2.f,
+	TEXT("Time budget (in ms) for ticking a single ImGui widget, used by time sliced widget logic (0 for no limit)."));
 
 #ifdef WITH_NET_IMGUI
 #define NETIMGUI_IMPLEMENTATION
@@ -50,22 +60,36 @@ static const char* GetNetImGuiClientName()
 	static FAnsiString ClientName = TCHAR_TO_UTF8(*FString::Printf(TEXT("%s"), FApp::GetProjectName()));
 	return *ClientName;
 }
+
+// same as NetImgui's default thread launcher, tagging everything the connection thread allocates
+static void StartNetImGuiThread(void ThreadedFunction(void*), void* ClientInfo)
+{
+	Async(EAsyncExecution::Thread, [ThreadedFunction, ClientInfo]()
+		{
+			FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::NetImgui };
+			ThreadedFunction(ClientInfo);
+		});
+}
 #endif
 
 void SImGuiWidgetBase::Construct(const FArguments& InArgs)
 {
 	UImGuiSubsystem* ImGuiSubsystem = UImGuiSubsystem::Get();
+	ImGuiSubsystem->EnsureFontsLoaded();
 
-	m_ImGuiContext = ImGui::CreateContext(ImGuiSubsystem->GetSharedFontAtlas());
-	m_ImPlotContext = ImPlot::CreateContext();
-	m_WidgetDrawers[0] = MakeShared<ImGuiUtils::FWidgetDrawer>();
-	m_WidgetDrawers[1] = MakeShared<ImGuiUtils::FWidgetDrawer>();
+	ImGuiUtils::FPooledImGuiContext PooledContext = ImGuiUtils::ContextPool.AcquireContext(ImGuiSubsystem->GetSharedFontAtlas());
+	m_ImGuiContext = PooledContext.ImguiContext;
+	m_ImPlotContext = PooledContext.ImplotContext;
+	m_WidgetDrawers[0] = MoveTemp(PooledContext.WidgetDrawers[0]);
+	m_WidgetDrawers[1] = MoveTemp(PooledContext.WidgetDrawers[1]);
 
 	m_TickContext = MakeUnique<FImGuiTickContext>();
 	m_TickContext->ImguiContext = m_ImGuiContext;
 	m_TickContext->ImplotContext = m_ImPlotContext;
 	FImGuiTickContext::SetTickContextUserData(m_ImGuiContext, m_TickContext.Get());
 
+	m_FrameTrace = MakeUnique<ImGuiUtils::FImGuiFrameTrace>();
+
 	if (InArgs._ConfigFileName && FCStringAnsi::Strlen(InArgs._ConfigFileName) > 2)
 	{
 		// sanitize filename
@@ -73,12 +97,28 @@ void SImGuiWidgetBase::Construct(const FArguments& InArgs)
 		FileName.RemoveSpacesInline();
 
 		m_ConfigFilePath = FAnsiString::Printf("%s/%s.ini", ImGuiSubsystem->GetIniDirectoryPath(), *FileName);
+
+		// used to identify the context in debug tools and traces
+		ImGui::SetContextName(m_ImGuiContext, *FileName);
 	}
 
 	FImGuiTickScope TickScope{ m_TickContext.Get() };
 
 	ImGuiIO& IO = m_ImGuiContext->IO;
-	IO.IniFilename = m_ConfigFilePath.IsEmpty() ? nullptr : *m_ConfigFilePath;
+	// settings are loaded here and saved through the subsystem file writer, keeps ImGui from writing files on the game thread
+	IO.IniFilename = nullptr;
+	if (!m_ConfigFilePath.IsEmpty())
+	{
+		TArray<uint8> PendingSettings;
+		if (ImGuiSubsystem->GetPendingFileContents(ANSI_TO_TCHAR(*m_ConfigFilePath), PendingSettings))
+		{
+			ImGui::LoadIniSettingsFromMemory((const char*)PendingSettings.GetData(), PendingSettings.Num());
+		}
+		else
+		{
+			ImGui::LoadIniSettingsFromDisk(*m_ConfigFilePath);
+		}
+	}
 
 	IO.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
 	IO.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
@@ -91,6 +131,16 @@ void SImGuiWidgetBase::Construct(const FArguments& InArgs)
 	IO.BackendPlatformName = "Unreal Engine";
 	IO.BackendRendererName = "Unreal Engine";
 
+#if WITH_ENGINE && IMGUI_ALLOW_LOCAL_DRAWING
+	// SDF font has its own atlas, the context updates/draws the textures of registered atlases only
+	// NOTE: only the engine drawer resolves SDF glyphs, other draw paths keep the shared atlas fonts (see BeginImGuiFrame)
+	m_SdfFont = ImGuiSubsystem->GetSdfFont();
+	if (m_SdfFont)
+	{
+		ImGui::RegisterFontAtlas(m_SdfFont->OwnerAtlas);
+	}
+#endif
+
 	if (InArgs._bEnableViewports && FSlateApplication::IsInitialized() && FPlatformProperties::SupportsWindowedMode())
 	{
 		IO.ConfigFlags  |= ImGuiConfigFlags_ViewportsEnable;
@@ -134,44 +184,8 @@ void SImGuiWidgetBase::Construct(const FArguments& InArgs)
 		PlatformIO.Platform_RenderWindow		= ImGuiUtils::UnrealPlatform_RenderWindow;
 		PlatformIO.Platform_OnChangedViewport	= nullptr;
 
-		FDisplayMetrics DisplayMetrics;
-		FDisplayMetrics::RebuildDisplayMetrics(DisplayMetrics);
-		if (DisplayMetrics.MonitorInfo.IsEmpty())
-		{
-			ImGuiPlatformMonitor ImguiMonitor;
-			ImguiMonitor.MainPos = ImVec2(0.f, 0.f);
-			ImguiMonitor.MainSize = ImVec2(DisplayMetrics.PrimaryDisplayWidth, DisplayMetrics.PrimaryDisplayHeight);
-			ImguiMonitor.WorkPos = ImVec2(DisplayMetrics.PrimaryDisplayWorkAreaRect.Left, DisplayMetrics.PrimaryDisplayWorkAreaRect.Top);
-			ImguiMonitor.WorkSize = ImVec2(DisplayMetrics.PrimaryDisplayWorkAreaRect.Right - DisplayMetrics.PrimaryDisplayWorkAreaRect.Left, DisplayMetrics.PrimaryDisplayWorkAreaRect.Bottom - DisplayMetrics.PrimaryDisplayWorkAreaRect.Top);
-			ImguiMonitor.DpiScale = 1.f;
-			ImguiMonitor.PlatformHandle = nullptr;
-
-			PlatformIO.Monitors.push_back(ImguiMonitor);
-		}
-		else
-		{
-			for (const FMonitorInfo& MonitorInfo : DisplayMetrics.MonitorInfo)
-			{
-				ImGuiPlatformMonitor ImguiMonitor;
-				ImguiMonitor.MainPos = ImVec2((float)MonitorInfo.DisplayRect.Left, (float)MonitorInfo.DisplayRect.Top);
-				ImguiMonitor.MainSize = ImVec2((float)(MonitorInfo.DisplayRect.Right - MonitorInfo.DisplayRect.Left),
-					(float)(MonitorInfo.DisplayRect.Bottom - MonitorInfo.DisplayRect.Top));
-				ImguiMonitor.WorkPos = ImVec2((float)MonitorInfo.WorkArea.Left, (float)MonitorInfo.WorkArea.Top);
-				ImguiMonitor.WorkSize = ImVec2((float)(MonitorInfo.WorkArea.Right - MonitorInfo.WorkArea.Left),
-					(float)(MonitorInfo.WorkArea.Bottom - MonitorInfo.WorkArea.Top));
-				ImguiMonitor.DpiScale = MonitorInfo.DPI / 96.f;
-				ImguiMonitor.PlatformHandle = nullptr;
-
-				if (MonitorInfo.bIsPrimary)
-				{
-					PlatformIO.Monitors.push_front(ImguiMonitor);
-				}
-				else
-				{
-					PlatformIO.Monitors.push_back(ImguiMonitor);
-				}
-			}
-		}
+		PlatformIO.Monitors = ImGuiUtils::MonitorCache.GetMonitors();
+		m_MonitorSerialNumber = ImGuiUtils::MonitorCache.GetSerialNumber();
 
 		ImGuiUtils::FImGuiViewportData* MainViewportData = IM_NEW(ImGuiUtils::FImGuiViewportData)();
 		MainViewportData->ViewportWindow = nullptr;
@@ -181,18 +195,21 @@ void SImGuiWidgetBase::Construct(const FArguments& InArgs)
 
 		ImGuiViewport* MainViewport = ImGui::GetMainViewport();
 		MainViewport->PlatformUserData = MainViewportData;
+
+		ImGuiUtils::ViewportWindowPool.RequestWarmUp(InArgs._MainViewportWindow);
 	}
 
 	// TODO: setting?
 	ImGui::StyleColorsDark();
 
 #ifdef WITH_NET_IMGUI
+	FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::NetImgui };
 	NetImgui::Startup();
 
 	int32 NetImGuiPort = GetNetImGuiPort();
 	if (NetImGuiPort != INDEX_NONE)
 	{
-		NetImgui::ConnectFromApp(GetNetImGuiClientName(), NetImGuiPort);
+		NetImgui::ConnectFromApp(GetNetImGuiClientName(), NetImGuiPort, &StartNetImGuiThread);
 	}
 #endif
 }
@@ -204,30 +221,34 @@ SImGuiWidgetBase::~SImGuiWidgetBase()
 		FImGuiTickScope TickScope{ m_TickContext.Get() };
 
 #ifdef WITH_NET_IMGUI
-		NetImgui::Shutdown();
+		{
+			FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::NetImgui };
+			NetImgui::Shutdown();
+		}
 #endif
 
-		ImGuiIO& IO = m_ImGuiContext->IO;
 		FImGuiTickContext::SetTickContextUserData(m_ImGuiContext, nullptr);
 
-		// duplicate of context shutdown operation as we clear the IniFilename here
-		if (m_ImGuiContext->SettingsLoaded && IO.IniFilename)
+		// duplicate of context shutdown operation (IniFilename is never set)
+		if (m_ImGuiContext->SettingsLoaded)
 		{
-			ImGui::SaveIniSettingsToDisk(IO.IniFilename);
+			QueueIniSettingsSave();
 		}
-		IO.IniFilename = nullptr;
 
 		ImGuiPlatformIO& PlatformIO = ImGui::GetPlatformIO();
 		PlatformIO.Platform_ClipboardUserData = nullptr;
-	}
 
-	// probably don't need to defer delete this
-	ImPlot::DestroyContext(m_ImPlotContext);
-	m_ImPlotContext = nullptr;
+		// pooled contexts only keep the shared font atlas (see Construct)
+		while (m_ImGuiContext->FontAtlases.Size > 1)
+		{
+			ImGui::UnregisterFontAtlas(m_ImGuiContext->FontAtlases.back());
+		}
+		m_ImGuiContext->IO.FontDefault = nullptr;
+	}
 
-	// NOTE: widget drawers should be queued before context
-	ImGuiUtils::DeferredDeletionQueue.DeferredDeleteObjects(MoveTemp(m_WidgetDrawers[0]), MoveTemp(m_WidgetDrawers[1]), m_ImGuiContext);
+	ImGuiUtils::DeferredDeletionQueue.DeferredReleaseContext(ImGuiUtils::FPooledImGuiContext{ m_ImGuiContext, m_ImPlotContext, { MoveTemp(m_WidgetDrawers[0]), MoveTemp(m_WidgetDrawers[1]) } });
 	m_ImGuiContext = nullptr;
+	m_ImPlotContext = nullptr;
 }
 
 void SImGuiWidgetBase::BeginImGuiFrame(const FGeometry& WidgetGeometry)
@@ -257,10 +278,63 @@ void SImGuiWidgetBase::BeginImGuiFrame(const FGeometry& WidgetGeometry)
 		ImGuiIO& IO = m_ImGuiContext->IO;
 
 		FVector2f WidgetSize = WidgetGeometry.GetAbsoluteSize();
+
+		// pick up monitor changes (display metrics are only rebuilt when the platform reports a change)
+		if ((IO.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) > 0)
+		{
+			// NOTE: same rounding as the main viewport position, see UnrealPlatform_GetWindowPosition
+			FSlateRect HostRect{};
+			if (CVarViewportsHostPopups.GetValueOnGameThread() && WidgetSize.X >= 1.f && WidgetSize.Y >= 1.f)
+			{
+				const FVector2f WidgetPosition = WidgetGeometry.GetAbsolutePosition();
+				HostRect = FSlateRect::FromPointAndExtent(FVector2f(FMath::RoundToFloat(WidgetPosition.X), FMath::RoundToFloat(WidgetPosition.Y)), WidgetSize);
+			}
+
+			if (m_MonitorSerialNumber != ImGuiUtils::MonitorCache.GetSerialNumber() || m_HostMonitorRect != HostRect)
+			{
+				if (HostRect != FSlateRect{})
+				{
+					const FVector2f HostPos = HostRect.GetTopLeft2f();
+					ImGuiUtils::MonitorCache.BuildHostedMonitors(ImVec2(HostPos.X, HostPos.Y), ImVec2(WidgetSize.X, WidgetSize.Y), ImGui::GetPlatformIO().Monitors);
+				}
+				else
+				{
+					ImGui::GetPlatformIO().Monitors = ImGuiUtils::MonitorCache.GetMonitors();
+				}
+				m_MonitorSerialNumber = ImGuiUtils::MonitorCache.GetSerialNumber();
+				m_HostMonitorRect = HostRect;
+			}
+		}
+
 		IO.DisplaySize = ImVec2(WidgetSize.X, WidgetSize.Y);
 		IO.DeltaTime = FApp::GetDeltaTime();
 
-		ImGui::NewFrame();
+		// transient allocations from the previous frame are no longer referenced
+		ImGuiMemory::ResetFrameArena(m_ImGuiContext);
+
+		FlushAnalogEvents(IO);
+		ImGuiUtils::CoalesceInputEvents(m_ImGuiContext);
+
+#ifdef WITH_NET_IMGUI
+		m_TickContext->bIsDrawingRemotely = NetImgui::IsConnected();
+#else
+		m_TickContext->bIsDrawingRemotely = false;
+#endif
+
+		// NetImgui renders the atlas textures as is, the distance field would show up as blurry glyphs
+		// NOTE: nullptr is the first font of the shared atlas
+		IO.FontDefault = m_TickContext->bIsDrawingRemotely ? nullptr : m_SdfFont;
+
+		{
+			ImGuiUtils::FImGuiFrameTraceScope TraceScope{ m_FrameTrace->NewFrameCycles };
+			ImGui::NewFrame();
+		}
+
+		// ImGui requests a save once its settings timer runs out (IniFilename is never set, see Construct)
+		if (IO.WantSaveIniSettings)
+		{
+			QueueIniSettingsSave();
+		}
 
 		if (m_TickContext->DragDropOperation.IsValid() && m_IsDragOverActive)
 		{
@@ -268,12 +342,6 @@ void SImGuiWidgetBase::BeginImGuiFrame(const FGeometry& WidgetGeometry)
 			ImGui::SetActiveID(-1, nullptr);
 		}
 	}
-
-#ifdef WITH_NET_IMGUI
-	m_TickContext->bIsDrawingRemotely = NetImgui::IsConnected();
-#else
-	m_TickContext->bIsDrawingRemotely = false;
-#endif
 }
 
 void SImGuiWidgetBase::EndImGuiFrame()
@@ -291,9 +359,19 @@ void SImGuiWidgetBase::EndImGuiFrame()
 		// slate widget doesn't process OnPaint/Tick logic when running headless
 
 		BeginImGuiFrame(GetCachedGeometry());
-		TickImGuiInternal(m_TickContext.Get());
+		{
+			FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::DrawLists };
+			ImGuiUtils::FImGuiFrameTraceScope TraceScope{ m_FrameTrace->TickCycles };
+			TickImGuiInternal(m_TickContext.Get());
+		}
 
-		ImGui::Render();
+		m_FrameTrace->CountFontAtlasUploads(m_ImGuiContext->PlatformIO);
+		{
+			FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::DrawLists };
+			ImGuiUtils::FImGuiFrameTraceScope TraceScope{ m_FrameTrace->RenderCycles };
+			ImGui::Render();
+		}
+		m_FrameTrace->EndFrame(m_ImGuiContext);
 
 		// just need to update the textures here.
 		UImGuiSubsystem* ImGuiSubsystem = UImGuiSubsystem::Get();
@@ -303,6 +381,7 @@ void SImGuiWidgetBase::EndImGuiFrame()
 	{
 		// the widget was not rendered this frame
 		ImGui::EndFrame();
+		m_FrameTrace->Reset();
 	}
 
 	if ((m_ImGuiContext->IO.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) > 0)
@@ -315,6 +394,12 @@ void SImGuiWidgetBase::EndImGuiFrame()
 	// m_CachedImGuiCursor = ImGui::GetMouseCursor();
 }
 
+double SImGuiWidgetBase::GetWidgetFrameBudgetSeconds()
+{
+	const float BudgetMs = CVarWidgetFrameBudget.GetValueOnGameThread();
+	return (BudgetMs > 0.f) ? (BudgetMs / 1000.0) : TNumericLimits<double>::Max();
+}
+
 void SImGuiWidgetBase::Tick(const FGeometry& WidgetGeometry, const double CurrentTime, const float DeltaTime)
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Tick Widget"), STAT_ImGui_TickWidget, STATGROUP_ImGui);
@@ -325,6 +410,9 @@ void SImGuiWidgetBase::Tick(const FGeometry& WidgetGeometry, const double Curren
 
 	BeginImGuiFrame(WidgetGeometry);
 
+	// window contents end up in draw lists, track them as such
+	FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::DrawLists };
+	ImGuiUtils::FImGuiFrameTraceScope TraceScope{ m_FrameTrace->TickCycles };
 	TickImGuiInternal(m_TickContext.Get());
 }
 
@@ -342,7 +430,13 @@ int32 SImGuiWidgetBase::OnPaint(const FPaintArgs& Args, const FGeometry& WidgetG
 
 	ImGuiIO& IO = m_ImGuiContext->IO;
 
-	ImGui::Render();
+	m_FrameTrace->CountFontAtlasUploads(m_ImGuiContext->PlatformIO);
+	{
+		FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::DrawLists };
+		ImGuiUtils::FImGuiFrameTraceScope TraceScope{ m_FrameTrace->RenderCycles };
+		ImGui::Render();
+	}
+	m_FrameTrace->EndFrame(m_ImGuiContext);
 
 	if ((IO.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) > 0)
 	{
@@ -369,14 +463,7 @@ int32 SImGuiWidgetBase::OnPaint(const FPaintArgs& Args, const FGeometry& WidgetG
 		ImGuiViewport* MainViewport = ImGui::GetMainViewport();
 		ImGuiUtils::FImGuiViewportData* ViewportData = (ImGuiUtils::FImGuiViewportData*)MainViewport->PlatformUserData;
 
-		// TODO: maybe find a better way to detect window docking operations? This is not expensive, just a bit ugly!
-		TSharedPtr<SWindow> PreviousParentWindow = ViewportData->ParentWindow.Pin();
-		TSharedPtr<SWindow> CurrentParentWindow = FSlateApplication::Get().FindWidgetWindow(AsShared());
-		if (ViewportData && (!PreviousParentWindow || (PreviousParentWindow != CurrentParentWindow)))
-		{
-			ViewportData->ParentWindow = CurrentParentWindow;
-			ViewportData->bInvalidateManagedViewportWindows = true;
-		}
+		UpdateParentWindow(OutDrawElements.GetPaintWindow());
 
 		if (!m_TickContext->bIsDrawingRemotely)
 		{
@@ -412,9 +499,35 @@ int32 SImGuiWidgetBase::OnPaint(const FPaintArgs& Args, const FGeometry& WidgetG
 	return LayerId;
 }
 
+bool SImGuiWidgetBase::UpdateParentWindow(const SWindow* PaintWindow) const
+{
+	ImGuiUtils::FImGuiViewportData* ViewportData = (m_ImGuiContext->Viewports.Size > 0) ? (ImGuiUtils::FImGuiViewportData*)m_ImGuiContext->Viewports[0]->PlatformUserData : nullptr;
+
+	// only walk the widget path after docking changes, the window we are painted into changes or the parent window goes away
+	const uint32 ParentWindowSerialNumber = ImGuiUtils::ParentWindowTracker.GetSerialNumber();
+	if (!ViewportData || (m_ParentWindowSerialNumber == ParentWindowSerialNumber && m_LastPaintWindow == PaintWindow && ViewportData->ParentWindow.IsValid()))
+	{
+		return false;
+	}
+
+	m_ParentWindowSerialNumber = ParentWindowSerialNumber;
+	m_LastPaintWindow = PaintWindow;
+
+	TSharedPtr<SWindow> PreviousParentWindow = ViewportData->ParentWindow.Pin();
+	TSharedPtr<SWindow> CurrentParentWindow = FSlateApplication::Get().FindWidgetWindow(AsShared());
+	if (!PreviousParentWindow || (PreviousParentWindow != CurrentParentWindow))
+	{
+		ViewportData->ParentWindow = CurrentParentWindow;
+		ViewportData->bInvalidateManagedViewportWindows = true;
+		ImGuiUtils::ViewportWindowPool.RequestWarmUp(CurrentParentWindow);
+	}
+	return true;
+}
+
 #pragma region SLATE_INPUT
 FReply SImGuiWidgetBase::OnFocusReceived(const FGeometry& MyGeometry, const FFocusEvent& InFocusEvent)
 {
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 	ImGuiIO& IO = m_ImGuiContext->IO;
 	IO.AddFocusEvent(true);
 	return FReply::Handled();
@@ -422,25 +535,52 @@ FReply SImGuiWidgetBase::OnFocusReceived(const FGeometry& MyGeometry, const FFoc
 
 void SImGuiWidgetBase::OnFocusLost(const FFocusEvent& InFocusEvent)
 {
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 	ImGuiIO& IO = m_ImGuiContext->IO;
 	IO.AddFocusEvent(false);
 }
 
+void SImGuiWidgetBase::QueueIniSettingsSave()
+{
+	// also clears IO.WantSaveIniSettings
+	size_t SettingsSize = 0;
+	const char* Settings = ImGui::SaveIniSettingsToMemory(&SettingsSize);
+
+	UImGuiSubsystem* ImGuiSubsystem = UImGuiSubsystem::Get();
+	if (ImGuiSubsystem && !m_ConfigFilePath.IsEmpty())
+	{
+		ImGuiSubsystem->QueueFileWrite(ANSI_TO_TCHAR(*m_ConfigFilePath), TArray<uint8>((const uint8*)Settings, (int32)SettingsSize));
+	}
+}
+
+void SImGuiWidgetBase::FlushAnalogEvents(ImGuiIO& IO)
+{
+	static_assert((int32)ImGuiUtils::EGamepadAxis::Count <= UE_ARRAY_COUNT(m_PendingAnalogValues), "pending analog values don't cover all gamepad axes");
+
+	for (uint32 PendingAxes = m_PendingAnalogAxes; PendingAxes != 0; PendingAxes &= (PendingAxes - 1))
+	{
+		const int32 AxisIndex = FMath::CountTrailingZeros(PendingAxes);
+		ImGuiUtils::AddGamepadAxisEvents(IO, (ImGuiUtils::EGamepadAxis)AxisIndex, m_PendingAnalogValues[AxisIndex]);
+	}
+	m_PendingAnalogAxes = 0;
+}
+
+
 void SImGuiWidgetBase::AddKeyEvent(ImGuiIO& IO, FKeyEvent KeyEvent, bool IsDown)
 {
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 	const ImGuiKey ImGuiKey = ImGuiUtils::UnrealToImGuiKey(KeyEvent.GetKey().GetFName());
 	if (ImGuiKey != ImGuiKey_None)
 	{
 		IO.AddKeyEvent(ImGuiKey, IsDown);
 	}
 
-	IO.AddKeyEvent(ImGuiMod_Shift, KeyEvent.GetModifierKeys().IsShiftDown());
-	IO.AddKeyEvent(ImGuiMod_Ctrl, KeyEvent.GetModifierKeys().IsControlDown());
-	IO.AddKeyEvent(ImGuiMod_Alt, KeyEvent.GetModifierKeys().IsAltDown());
+	ImGuiUtils::AddModifierKeyEvents(IO, KeyEvent.GetModifierKeys());
 }
 
 FReply SImGuiWidgetBase::OnKeyChar(const FGeometry& WidgetGeometry, const FCharacterEvent& CharacterEvent)
 {
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 	ImGuiIO& IO = m_ImGuiContext->IO;
 	IO.AddInputCharacterUTF16(CharacterEvent.GetCharacter());
 	return IO.WantTextInput ? FReply::Handled() : FReply::Unhandled();
@@ -476,6 +616,7 @@ FReply SImGuiWidgetBase::OnKeyUp(const FGeometry& WidgetGeometry, const FKeyEven
 
 void SImGuiWidgetBase::OnMouseLeave(const FPointerEvent& MouseEvent)
 {
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 	ImGuiIO& IO = m_ImGuiContext->IO;
 
 	if (!HasMouseCapture())
@@ -502,6 +643,7 @@ FReply SImGuiWidgetBase::OnMouseButtonDown(const FGeometry& WidgetGeometry, cons
 
 	if (IO.WantCaptureMouse)
 	{
+		INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 		IO.AddMouseButtonEvent(ImGuiUtils::UnrealToImGuiMouseButton(MouseEvent.GetEffectingButton()), /*down=*/true);
 
 		FSlateThrottleManager::Get().DisableThrottle(true);
@@ -512,6 +654,7 @@ FReply SImGuiWidgetBase::OnMouseButtonDown(const FGeometry& WidgetGeometry, cons
 
 FReply SImGuiWidgetBase::OnMouseButtonUp(const FGeometry& WidgetGeometry, const FPointerEvent& MouseEvent)
 {
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 	ImGuiIO& IO = m_ImGuiContext->IO;
 	IO.AddMouseButtonEvent(ImGuiUtils::UnrealToImGuiMouseButton(MouseEvent.GetEffectingButton()), /*down=*/false);
 
@@ -525,6 +668,7 @@ FReply SImGuiWidgetBase::OnMouseButtonUp(const FGeometry& WidgetGeometry, const
 
 FReply SImGuiWidgetBase::OnMouseButtonDoubleClick(const FGeometry& WidgetGeometry, const FPointerEvent& MouseEvent)
 {
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 	ImGuiIO& IO = m_ImGuiContext->IO;
 	IO.AddMouseButtonEvent(ImGuiUtils::UnrealToImGuiMouseButton(MouseEvent.GetEffectingButton()), /*down=*/true);
 
@@ -540,6 +684,8 @@ FReply SImGuiWidgetBase::OnMouseWheel(const FGeometry& WidgetGeometry, const FPo
 		return FReply::Unhandled();
 	}
 
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
+
 	// initial zoom support
 	if (IO.KeyCtrl)
 	{
@@ -557,23 +703,40 @@ FReply SImGuiWidgetBase::OnMouseWheel(const FGeometry& WidgetGeometry, const FPo
 
 FReply SImGuiWidgetBase::OnMouseMove(const FGeometry& WidgetGeometry, const FPointerEvent& MouseEvent)
 {
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 	ImGuiIO& IO = m_ImGuiContext->IO;
 	FVector2f MousePosition = MouseEvent.GetScreenSpacePosition();
 	if ((IO.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) == 0)
 	{
 		MousePosition = WidgetGeometry.AbsoluteToLocal(MousePosition);
 	}
-	IO.AddMousePosEvent(MousePosition.X, MousePosition.Y);
+	ImGuiUtils::AddMousePosEventCoalesced(IO, MousePosition.X, MousePosition.Y);
 
 	return FReply::Unhandled();
 }
 
 FReply SImGuiWidgetBase::OnAnalogValueChanged(const FGeometry& MyGeometry, const FAnalogInputEvent& AnalogInputEvent)
 {
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 	ImGuiIO& IO = m_ImGuiContext->IO;
 
-	float Value = AnalogInputEvent.GetAnalogValue();
-	IO.AddKeyAnalogEvent(ImGuiUtils::UnrealToImGuiKey(AnalogInputEvent.GetKey().GetFName()), FMath::Abs(Value) > 0.1f, Value);
+	const float Value = AnalogInputEvent.GetAnalogValue();
+	const int32 AxisIndex = ImGuiUtils::UnrealToGamepadAxis(AnalogInputEvent.GetKey());
+	if (AxisIndex != INDEX_NONE)
+	{
+		// axes report every frame, only the latest value is submitted (see FlushAnalogEvents)
+		m_PendingAnalogValues[AxisIndex] = Value;
+		m_PendingAnalogAxes |= (1u << AxisIndex);
+	}
+	else
+	{
+		// digital edges are submitted right away, a press and release within the same frame must both reach ImGui
+		const ImGuiKey Key = ImGuiUtils::UnrealToImGuiKey(AnalogInputEvent.GetKey().GetFName());
+		if (Key != ImGuiKey_None)
+		{
+			IO.AddKeyAnalogEvent(Key, FMath::Abs(Value) > 0.1f, Value);
+		}
+	}
 
 	return IO.WantCaptureKeyboard ? FReply::Handled() : FReply::Unhandled();
 }
@@ -603,6 +766,7 @@ static bool AllowDragDropOperation(const FDragDropOperation* Operation)
 
 void SImGuiWidgetBase::OnDragLeave(const FDragDropEvent& DragDropEvent)
 {
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 	m_IsDragOverActive = false;
 
 	ImGuiIO& IO = m_ImGuiContext->IO;
@@ -611,6 +775,7 @@ void SImGuiWidgetBase::OnDragLeave(const FDragDropEvent& DragDropEvent)
 
 FReply SImGuiWidgetBase::OnDragOver(const FGeometry& WidgetGeometry, const FDragDropEvent& DragDropEvent)
 {
+	INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 	m_IsDragOverActive = true;
 
 	ImGuiIO& IO = m_ImGuiContext->IO;
@@ -619,7 +784,7 @@ FReply SImGuiWidgetBase::OnDragOver(const FGeometry& WidgetGeometry, const FDrag
 	{
 		MousePosition = WidgetGeometry.AbsoluteToLocal(MousePosition);
 	}
-	IO.AddMousePosEvent(MousePosition.X, MousePosition.Y);
+	ImGuiUtils::AddMousePosEventCoalesced(IO, MousePosition.X, MousePosition.Y);
 
 	// NOTE: this is incorrect but needed to receive the OnDrop event :(
 	return AllowDragDropOperation(DragDropEvent.GetOperation().Get()) ? FReply::Handled() : FReply::Unhandled();
@@ -652,6 +817,8 @@ void SImGuiWidget::TickImGuiInternal(FImGuiTickContext* TickContext)
 {
 	FImGuiTickScope TickScope{ TickContext };
 
+	TickContext->BeginFrameBudget(GetWidgetFrameBudgetSeconds());
+
 	if (m_bSkipWindowCreation)
 	{
 		m_OnTickDelegate.ExecuteIfBound(TickContext);
@@ -669,3 +836,46 @@ void SImGuiWidget::TickImGuiInternal(FImGuiTickContext* TickContext)
 		ImGui::End();
 	}
 }
+
+namespace ImGuiUtils
+{
+	// called at module startup, key names are registered by InputCore
+	void InitializeKeyTranslationTable()
+	{
+		KeyTranslationTable.Build();
+	}
+
+	int32 GetNumFreePooledContexts()
+	{
+		return ContextPool.GetNumFreeContexts();
+	}
+
+	FScopedOffscreenImGuiContext::FScopedOffscreenImGuiContext(UImGuiSubsystem* ImGuiSubsystem, const ImVec2& DisplaySize)
+		: PrevImGuiContext(ImGui::GetCurrentContext())
+		, PrevImPlotContext(ImPlot::GetCurrentContext())
+	{
+		ImGuiSubsystem->EnsureFontsLoaded();
+		Context = MakeUnique<FPooledImGuiContext>(ContextPool.AcquireContext(ImGuiSubsystem->GetSharedFontAtlas()));
+		ImGui::SetCurrentContext(Context->ImguiContext);
+		ImPlot::SetCurrentContext(Context->ImplotContext);
+
+		ImGuiIO& IO = ImGui::GetIO();
+		IO.IniFilename = nullptr;
+		IO.DisplaySize = DisplaySize;
+		IO.DeltaTime = 1.f / 60.f;
+		IO.BackendFlags |= ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasVtxOffset;
+	}
+
+	FScopedOffscreenImGuiContext::~FScopedOffscreenImGuiContext()
+	{
+		// destroying the context clears the current one
+		ContextPool.ReleaseContext(MoveTemp(*Context), /*bForceDestroy=*/true);
+		ImGui::SetCurrentContext(PrevImGuiContext);
+		ImPlot::SetCurrentContext(PrevImPlotContext);
+	}
+
+	ImGuiContext* FScopedOffscreenImGuiContext::GetContext() const
+	{
+		return Context->ImguiContext;
+	}
+}
@@ -0,0 +1,530 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#include "ImGuiPluginTypes.h"
+#include "ImGuiSubsystem.h"
+#include "SImGuiWidgets.h"
+#include "Widgets/SWindow.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Layout/SBox.h"
+#include "HAL/IConsoleManager.h"
+#include "Framework/Application/SlateApplication.h"
+
+#include "ImGuiContextPool.h"
+#include "ImGuiGlyphInstances.h"
+#include "ImGuiOcclusionCulling.h"
+
+// `imgui.Benchmark.<Name> [<CountName>=<DefaultCount>]`, the count is clamped to [MinCount, MaxCount] and results are logged to the console
+class FImGuiBenchmarkCommand : FNoncopyable
+{
+public:
+	using FBenchmarkFunction = void(*)(UImGuiSubsystem& ImGuiSubsystem, int32 Count, FOutputDevice& Ar);
+
+	FImGuiBenchmarkCommand(const TCHAR* Name, const TCHAR* Help, const TCHAR* CountName, int32 DefaultCount, int32 MinCount, int32 MaxCount, FBenchmarkFunction Function)
+		: Command(
+			*FString::Printf(TEXT("imgui.Benchmark.%s"), Name),
+			*FString::Printf(TEXT("%s\nUsage: imgui.Benchmark.%s [%s=%d]"), Help, Name, CountName, DefaultCount),
+			FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([=](const TArray<FString>& Args, FOutputDevice& Ar)
+				{
+					if (UImGuiSubsystem* ImGuiSubsystem = UImGuiSubsystem::Get(Ar))
+					{
+						const int32 Count = FMath::Clamp(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : DefaultCount, MinCount, MaxCount);
+						Function(*ImGuiSubsystem, Count, Ar);
+					}
+				}))
+	{
+	}
+
+	// wall time of `Func` in seconds
+	template<typename FuncType>
+	static double Measure(FuncType&& Func)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		Func();
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+private:
+	FAutoConsoleCommandWithArgsAndOutputDevice Command;
+};
+
+/*--------------------------------------------------------------------------------------------------------------------------*/
+
+static void BenchmarkWidgetSpawning(UImGuiSubsystem& ImGuiSubsystem, int32 WidgetCount, FOutputDevice& Ar)
+{
+	double PooledSpawnTime = 0.0;
+	double UnpooledSpawnTime = 0.0;
+	double MaxSpawnTime = 0.0;
+	int32 PooledSpawnCount = 0;
+
+	TArray<TSharedPtr<SImGuiWidget>> Widgets;
+	Widgets.Reserve(WidgetCount);
+	for (int32 WidgetIndex = 0; WidgetIndex < WidgetCount; ++WidgetIndex)
+	{
+		const bool bUsesPooledContext = ImGuiUtils::GetNumFreePooledContexts() > 0;
+
+		const double SpawnTime = FImGuiBenchmarkCommand::Measure([&Widgets]() { Widgets.Add(SNew(SImGuiWidget)); });
+		MaxSpawnTime = FMath::Max(MaxSpawnTime, SpawnTime);
+		if (bUsesPooledContext)
+		{
+			PooledSpawnTime += SpawnTime;
+			++PooledSpawnCount;
+		}
+		else
+		{
+			UnpooledSpawnTime += SpawnTime;
+		}
+	}
+
+	const double DestroyTime = FImGuiBenchmarkCommand::Measure([&Widgets]() { Widgets.Reset(); });
+
+	const int32 UnpooledSpawnCount = WidgetCount - PooledSpawnCount;
+	Ar.Logf(TEXT("ImGui widget spawn benchmark (%d widgets):"), WidgetCount);
+	Ar.Logf(TEXT("  pooled   : %d spawns, avg %.3f ms"), PooledSpawnCount, PooledSpawnCount > 0 ? (PooledSpawnTime * 1000.0 / PooledSpawnCount) : 0.0);
+	Ar.Logf(TEXT("  unpooled : %d spawns, avg %.3f ms"), UnpooledSpawnCount, UnpooledSpawnCount > 0 ? (UnpooledSpawnTime * 1000.0 / UnpooledSpawnCount) : 0.0);
+	Ar.Logf(TEXT("  max spawn %.3f ms, destroy all %.3f ms"), MaxSpawnTime * 1000.0, DestroyTime * 1000.0);
+}
+
+static FImGuiBenchmarkCommand CmdBenchmarkWidgetSpawning(
+	TEXT("SpawnWidgets"),
+	TEXT("Creates and destroys N ImGui widgets and reports spawn cost with and without pooled contexts."),
+	TEXT("Count"), 50, 1, 1000,
+	&BenchmarkWidgetSpawning);
+
+/*--------------------------------------------------------------------------------------------------------------------------*/
+
+static void BenchmarkFrameAllocations(UImGuiSubsystem& ImGuiSubsystem, int32 FrameCount, FOutputDevice& Ar)
+{
+	ImGuiUtils::FScopedOffscreenImGuiContext Context{ &ImGuiSubsystem };
+
+	// typical widget code building temporary strings and plot data every frame
+	auto RunFrames = [&](bool bUseFrameArena, int32 NumFrames)
+		{
+			for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+			{
+				ImGuiMemory::ResetFrameArena(Context.GetContext());
+				ImGui::NewFrame();
+
+				ImGui::Begin("Frame Allocations Benchmark");
+				{
+					// NOTE: only the temporaries go through the arena, ImGui calls can grow persistent buffers
+					ImVector<float> Values;
+					{
+						TOptional<FImGuiTransientMemoryScope> TransientScope;
+						if (bUseFrameArena)
+						{
+							TransientScope.Emplace();
+						}
+						for (int32 ValueIndex = 0; ValueIndex < 512; ++ValueIndex)
+						{
+							Values.push_back(FMath::Sin(ValueIndex * 0.05f + FrameIndex * 0.1f));
+						}
+					}
+					ImGui::PlotLines("Values", Values.Data, Values.Size);
+
+					for (int32 LineIndex = 0; LineIndex < 64; ++LineIndex)
+					{
+						ImGuiTextBuffer Line;
+						{
+							TOptional<FImGuiTransientMemoryScope> TransientScope;
+							if (bUseFrameArena)
+							{
+								TransientScope.Emplace();
+							}
+							Line.appendf("Item %d: %.3f", LineIndex, Values[LineIndex]);
+						}
+						ImGui::TextUnformatted(Line.begin(), Line.end());
+					}
+				}
+				ImGui::End();
+
+				ImGui::Render();
+			}
+		};
+
+	auto MeasureHeapAllocations = [&](bool bUseFrameArena)
+		{
+			// warm up persistent buffers (window, draw lists, arena blocks)
+			RunFrames(bUseFrameArena, 10);
+
+			const uint64 StartAllocationCount = ImGuiMemory::GetHeapAllocationCount();
+			RunFrames(bUseFrameArena, FrameCount);
+			return double(ImGuiMemory::GetHeapAllocationCount() - StartAllocationCount) / FrameCount;
+		};
+
+	const double HeapAllocationsPerFrame = MeasureHeapAllocations(false);
+	const double ArenaHeapAllocationsPerFrame = MeasureHeapAllocations(true);
+
+	Ar.Logf(TEXT("ImGui frame allocation benchmark (%d frames):"), FrameCount);
+	Ar.Logf(TEXT("  heap             : %.2f allocations per frame"), HeapAllocationsPerFrame);
+	Ar.Logf(TEXT("  with frame arena : %.2f allocations per frame"), ArenaHeapAllocationsPerFrame);
+}
+
+static FImGuiBenchmarkCommand CmdBenchmarkFrameAllocations(
+	TEXT("FrameAllocations"),
+	TEXT("Runs N offscreen ImGui frames with temporary allocations and reports heap allocations per frame with and without the frame arena."),
+	TEXT("Frames"), 100, 1, 10000,
+	&BenchmarkFrameAllocations);
+
+/*--------------------------------------------------------------------------------------------------------------------------*/
+
+static void BenchmarkParentWindowLookup(UImGuiSubsystem& ImGuiSubsystem, int32 WidgetCount, FOutputDevice& Ar)
+{
+	if (!FSlateApplication::IsInitialized())
+	{
+		Ar.Log(TEXT("Slate is not initialized."));
+		return;
+	}
+
+	const int32 PaintCount = 100;
+	// roughly the depth of a widget docked in a tab (dock area, splitters, tab well etc..)
+	const int32 NestingDepth = 12;
+
+	TArray<TSharedRef<SImGuiWidget>> Widgets;
+	TSharedRef<SVerticalBox> WidgetContainer = SNew(SVerticalBox);
+	for (int32 WidgetIndex = 0; WidgetIndex < WidgetCount; ++WidgetIndex)
+	{
+		// NOTE: parent window is only tracked for the viewports
+		TSharedRef<SImGuiWidget> Widget = SNew(SImGuiWidget);
+		Widgets.Add(Widget);
+
+		TSharedRef<SWidget> NestedWidget = Widget;
+		for (int32 Depth = 0; Depth < NestingDepth; ++Depth)
+		{
+			NestedWidget = SNew(SBox)[NestedWidget];
+		}
+		WidgetContainer->AddSlot()[NestedWidget];
+	}
+
+	TSharedRef<SWindow> Window = SNew(SWindow)
+		.Title(FText::FromString(TEXT("ImGui Parent Window Benchmark")))
+		.ClientSize(FVector2D(256.f, 256.f))
+		[
+			WidgetContainer
+		];
+	FSlateApplication::Get().AddWindow(Window, /*bShowImmediately=*/false);
+
+	// previous behavior, every paint searched all slate windows for the widget
+	const double LookupTime = FImGuiBenchmarkCommand::Measure([&]()
+		{
+			for (int32 PaintIndex = 0; PaintIndex < PaintCount; ++PaintIndex)
+			{
+				for (const TSharedRef<SImGuiWidget>& Widget : Widgets)
+				{
+					TSharedPtr<SWindow> ParentWindow = FSlateApplication::Get().FindWidgetWindow(Widget);
+					ensure(ParentWindow == Window);
+				}
+			}
+		});
+
+	// current behavior, each widget caches its parent window until tabs move or the paint window changes (same call as OnPaint)
+	int32 NumLookups = 0;
+	const double CachedTime = FImGuiBenchmarkCommand::Measure([&]()
+		{
+			for (int32 PaintIndex = 0; PaintIndex < PaintCount; ++PaintIndex)
+			{
+				for (const TSharedRef<SImGuiWidget>& Widget : Widgets)
+				{
+					NumLookups += Widget->UpdateParentWindow(&Window.Get()) ? 1 : 0;
+				}
+			}
+		});
+
+	FSlateApplication::Get().RequestDestroyWindow(Window);
+
+	const int32 NumPaints = PaintCount * WidgetCount;
+	Ar.Logf(TEXT("ImGui parent window lookup benchmark (%d widgets, %d frames):"), WidgetCount, PaintCount);
+	Ar.Logf(TEXT("  per paint lookup : %.3f us per paint, %.3f ms per frame"), LookupTime * 1000000.0 / NumPaints, LookupTime * 1000.0 / PaintCount);
+	Ar.Logf(TEXT("  cached           : %.3f us per paint, %.3f ms per frame (%d lookups)"), CachedTime * 1000000.0 / NumPaints, CachedTime * 1000.0 / PaintCount, NumLookups);
+}
+
+static FImGuiBenchmarkCommand CmdBenchmarkParentWindowLookup(
+	TEXT("ParentWindowLookup"),
+	TEXT("Docks N ImGui widgets in a hidden window and reports the per paint cost of resolving their parent window, with and without caching."),
+	TEXT("Count"), 20, 1, 200,
+	&BenchmarkParentWindowLookup);
+
+/*--------------------------------------------------------------------------------------------------------------------------*/
+
+static void BenchmarkFontZoom(UImGuiSubsystem& ImGuiSubsystem, int32 StepCount, FOutputDevice& Ar)
+{
+	ImGuiUtils::FScopedOffscreenImGuiContext Context{ &ImGuiSubsystem };
+	ImGuiIO& IO = ImGui::GetIO();
+
+	ImFont* SdfFont = ImGuiSubsystem.GetSdfFont();
+	if (SdfFont)
+	{
+		ImGui::RegisterFontAtlas(SdfFont->OwnerAtlas);
+	}
+
+	struct FZoomResult
+	{
+		int32 BakedSizes = 0;
+		int32 StartAtlasSizeKB = 0;
+		int32 EndAtlasSizeKB = 0;
+		double MaxStepTime = 0.0;
+	};
+
+	// same steps as ctrl + mouse wheel zoom (see OnMouseWheel), back and forth between 1x and 4x
+	auto MeasureZoom = [&](ImFont* Font)
+		{
+			ImFontAtlas* Atlas = Font->OwnerAtlas;
+			auto GetAtlasSizeKB = [Atlas]() { return Atlas->TexData->Width * Atlas->TexData->Height * Atlas->TexData->BytesPerPixel / 1024; };
+
+			FZoomResult Result;
+			Result.StartAtlasSizeKB = GetAtlasSizeKB();
+
+			IO.FontDefault = Font;
+			for (int32 StepIndex = 0; StepIndex < StepCount; ++StepIndex)
+			{
+				const int32 ZoomStep = StepIndex % 60;
+				Context.GetContext()->Style.FontScaleMain = 1.f + 0.1f * (ZoomStep < 30 ? ZoomStep : 60 - ZoomStep);
+
+				const double StepTime = FImGuiBenchmarkCommand::Measure([]()
+					{
+						ImGui::NewFrame();
+						ImGui::Begin("Font Zoom Benchmark");
+						for (int32 LineIndex = 0; LineIndex < 8; ++LineIndex)
+						{
+							ImGui::Text("The quick brown fox jumps over the lazy dog %d !\"#$%%&'()*+,-./:;<=>?@[\\]^_`{|}~", LineIndex);
+						}
+						ImGui::End();
+						ImGui::Render();
+					});
+				Result.MaxStepTime = FMath::Max(Result.MaxStepTime, StepTime);
+			}
+
+			Result.EndAtlasSizeKB = GetAtlasSizeKB();
+			for (int32 BakedIndex = 0; BakedIndex < Atlas->Builder->BakedPool.Size; ++BakedIndex)
+			{
+				const ImFontBaked& Baked = Atlas->Builder->BakedPool[BakedIndex];
+				Result.BakedSizes += (Baked.OwnerFont == Font && !Baked.WantDestroy) ? 1 : 0;
+			}
+			return Result;
+		};
+
+	const FZoomResult BitmapResult = MeasureZoom(ImGuiSubsystem.GetSharedFontAtlas()->Fonts[0]);
+	const FZoomResult SdfResult = SdfFont ? MeasureZoom(SdfFont) : FZoomResult();
+
+	// pooled contexts only keep the shared font atlas
+	if (SdfFont)
+	{
+		ImGui::UnregisterFontAtlas(SdfFont->OwnerAtlas);
+	}
+	IO.FontDefault = nullptr;
+
+	Ar.Logf(TEXT("ImGui font zoom benchmark (%d zoom steps):"), StepCount);
+	Ar.Logf(TEXT("  bitmap : %d baked sizes, atlas %d KB -> %d KB, max step %.3f ms"), BitmapResult.BakedSizes, BitmapResult.StartAtlasSizeKB, BitmapResult.EndAtlasSizeKB, BitmapResult.MaxStepTime * 1000.0);
+	if (SdfFont)
+	{
+		Ar.Logf(TEXT("  sdf    : %d baked sizes, atlas %d KB -> %d KB, max step %.3f ms"), SdfResult.BakedSizes, SdfResult.StartAtlasSizeKB, SdfResult.EndAtlasSizeKB, SdfResult.MaxStepTime * 1000.0);
+	}
+	else
+	{
+		Ar.Log(TEXT("  sdf    : disabled (imgui.Fonts.SDF=1 to compare)"));
+	}
+}
+
+static FImGuiBenchmarkCommand CmdBenchmarkFontZoom(
+	TEXT("FontZoom"),
+	TEXT("Steps the font scale of an offscreen ImGui context like ctrl + mouse wheel zoom and reports baked font sizes and atlas size, for the default and the SDF font."),
+	TEXT("Steps"), 30, 1, 1000,
+	&BenchmarkFontZoom);
+
+/*--------------------------------------------------------------------------------------------------------------------------*/
+
+static void BenchmarkGlyphInstancing(UImGuiSubsystem& ImGuiSubsystem, int32 LineCount, FOutputDevice& Ar)
+{
+	// NOTE: cvar lives with the widget drawer
+	const int32 MinRunLength = IConsoleManager::Get().FindConsoleVariable(TEXT("imgui.GlyphInstancing.MinRunLength"))->GetInt();
+
+	ImGuiUtils::FScopedOffscreenImGuiContext Context{ &ImGuiSubsystem, ImVec2(1920.f, 1080.f) };
+	ImGuiIO& IO = ImGui::GetIO();
+
+	// log window tall enough for every line to be drawn (clipped lines don't generate geometry)
+	// NOTE: first frame bakes the glyphs and measures the line height
+	for (int32 FrameIndex = 0; FrameIndex < 2; ++FrameIndex)
+	{
+		ImGui::NewFrame();
+		ImGui::SetNextWindowPos(ImVec2(0.f, 0.f));
+		ImGui::SetNextWindowSize(IO.DisplaySize);
+		ImGui::Begin("Glyph Instancing Benchmark", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings);
+		for (int32 LineIndex = 0; LineIndex < LineCount; ++LineIndex)
+		{
+			ImGui::Text("[%05d] LogImGui: Display: Frame %d took %.2f ms (%d draw calls, %d vertices)", LineIndex, LineIndex * 3, LineIndex * 0.013f, LineIndex % 97, LineIndex * 31);
+		}
+		const float LineHeight = ImGui::GetTextLineHeightWithSpacing();
+		ImGui::End();
+		ImGui::Render();
+
+		IO.DisplaySize.y = LineCount * LineHeight + ImGui::GetStyle().WindowPadding.y * 2.f;
+	}
+	const ImDrawData* DrawData = ImGui::GetDrawData();
+
+	struct FUploadResult
+	{
+		SIZE_T UploadSize = 0;
+		int32 Instances = 0;
+		int32 Rects = 0;
+		double BuildTime = 0.0;
+	};
+
+	// build + write the buffers the widget drawer would upload
+	ImGuiUtils::FImGuiGlyphInstances GlyphInstances;
+	TArray<ImDrawVert> VertexScratch;
+	TArray<ImDrawIdx> IndexScratch;
+	auto MeasureUpload = [&](bool bInstanceGlyphs)
+		{
+			FUploadResult Result;
+			Result.BuildTime = FImGuiBenchmarkCommand::Measure([&]()
+				{
+					GlyphInstances.Build(DrawData, bInstanceGlyphs, MinRunLength);
+					VertexScratch.SetNumUninitialized(GlyphInstances.GetNumVertices(), EAllowShrinking::No);
+					IndexScratch.SetNumUninitialized(GlyphInstances.GetNumIndices(), EAllowShrinking::No);
+					GlyphInstances.WriteVertices(DrawData, VertexScratch.GetData());
+					GlyphInstances.WriteIndices(DrawData, IndexScratch.GetData());
+				});
+			Result.UploadSize = GlyphInstances.GetUploadSize();
+			Result.Instances = GlyphInstances.GetInstances().Num();
+			Result.Rects = GlyphInstances.GetRects().Num();
+			return Result;
+		};
+
+	const FUploadResult IndexedResult = MeasureUpload(false);
+	const FUploadResult InstancedResult = MeasureUpload(true);
+
+	Ar.Logf(TEXT("ImGui glyph instancing benchmark (%d log lines):"), LineCount);
+	Ar.Logf(TEXT("  indexed   : %.1f KB uploaded, build %.3f ms"), IndexedResult.UploadSize / 1024.0, IndexedResult.BuildTime * 1000.0);
+	Ar.Logf(TEXT("  instanced : %.1f KB uploaded (%d glyph instances, %d glyph rects), build %.3f ms"), InstancedResult.UploadSize / 1024.0, InstancedResult.Instances, InstancedResult.Rects, InstancedResult.BuildTime * 1000.0);
+	Ar.Logf(TEXT("  upload reduction : %.2fx"), InstancedResult.UploadSize > 0 ? double(IndexedResult.UploadSize) / InstancedResult.UploadSize : 0.0);
+}
+
+static FImGuiBenchmarkCommand CmdBenchmarkGlyphInstancing(
+	TEXT("GlyphInstancing"),
+	TEXT("Draws a log window with every line visible in an offscreen ImGui context and reports the vertex/index upload size with and without glyph instancing."),
+	TEXT("Lines"), 10000, 1, 100000,
+	&BenchmarkGlyphInstancing);
+
+/*--------------------------------------------------------------------------------------------------------------------------*/
+
+static void BenchmarkShapes(UImGuiSubsystem& ImGuiSubsystem, int32 ShapeCount, FOutputDevice& Ar)
+{
+	ImGuiUtils::FScopedOffscreenImGuiContext Context{ &ImGuiSubsystem, ImVec2(1920.f, 1080.f) };
+
+	struct FShapesResult
+	{
+		int32 Vertices = 0;
+		int32 Indices = 0;
+		double BuildTime = 0.0;
+	};
+
+	// scatter markers, node graph boxes and links
+	auto MeasureShapes = [&](bool bUseShapes)
+		{
+			ImGui::NewFrame();
+			ImDrawList* DrawList = ImGui::GetBackgroundDrawList();
+
+			FShapesResult Result;
+			Result.BuildTime = FImGuiBenchmarkCommand::Measure([&]()
+				{
+					if (bUseShapes)
+					{
+						ImGuiShapes::BeginShapes(DrawList);
+					}
+					for (int32 ShapeIndex = 0; ShapeIndex < ShapeCount; ++ShapeIndex)
+					{
+						const ImVec2 Pos = ImVec2((ShapeIndex * 37) % 1900 + 10.f, (ShapeIndex * 53) % 1060 + 10.f);
+						const ImU32 Color = IM_COL32(ShapeIndex % 255, 128, 255 - ShapeIndex % 255, 255);
+						switch (ShapeIndex % 4)
+						{
+						case 0: bUseShapes ? ImGuiShapes::AddCircleFilled(DrawList, Pos, 4.f, Color) : DrawList->AddCircleFilled(Pos, 4.f, Color); break;
+						case 1: bUseShapes ? ImGuiShapes::AddCircle(DrawList, Pos, 6.f, Color, 1.5f) : DrawList->AddCircle(Pos, 6.f, Color, 0, 1.5f); break;
+						case 2: bUseShapes ? ImGuiShapes::AddRectFilled(DrawList, Pos, Pos + ImVec2(60.f, 30.f), Color, 4.f) : DrawList->AddRectFilled(Pos, Pos + ImVec2(60.f, 30.f), Color, 4.f); break;
+						case 3: bUseShapes ? ImGuiShapes::AddLine(DrawList, Pos, Pos + ImVec2(40.f, 25.f), Color, 2.f) : DrawList->AddLine(Pos, Pos + ImVec2(40.f, 25.f), Color, 2.f); break;
+						}
+					}
+					if (bUseShapes)
+					{
+						ImGuiShapes::EndShapes(DrawList);
+					}
+				});
+			Result.Vertices = DrawList->VtxBuffer.Size;
+			Result.Indices = DrawList->IdxBuffer.Size;
+			ImGui::Render();
+			return Result;
+		};
+
+	// NOTE: shapes fall back to ImDrawList when disabled
+	const bool bShapesEnabled = IConsoleManager::Get().FindConsoleVariable(TEXT("imgui.Shapes.Enable"))->GetBool();
+	const FShapesResult TessellatedResult = MeasureShapes(false);
+	const FShapesResult ShapesResult = MeasureShapes(true);
+
+	Ar.Logf(TEXT("ImGui shapes benchmark (%d shapes):"), ShapeCount);
+	Ar.Logf(TEXT("  ImDrawList  : %d vertices, %d indices, build %.3f ms"), TessellatedResult.Vertices, TessellatedResult.Indices, TessellatedResult.BuildTime * 1000.0);
+	Ar.Logf(TEXT("  ImGuiShapes : %d vertices, %d indices, build %.3f ms%s"), ShapesResult.Vertices, ShapesResult.Indices, ShapesResult.BuildTime * 1000.0, bShapesEnabled ? TEXT("") : TEXT(" (disabled, imgui.Shapes.Enable=1 to compare)"));
+}
+
+static FImGuiBenchmarkCommand CmdBenchmarkShapes(
+	TEXT("Shapes"),
+	TEXT("Draws circles, rounded rects and lines with ImDrawList and ImGuiShapes in an offscreen ImGui context and reports vertex/index counts."),
+	TEXT("Count"), 20000, 1, 1000000,
+	&BenchmarkShapes);
+
+/*--------------------------------------------------------------------------------------------------------------------------*/
+
+static void BenchmarkOcclusionCulling(UImGuiSubsystem& ImGuiSubsystem, int32 WindowCount, FOutputDevice& Ar)
+{
+	ImGuiUtils::FScopedOffscreenImGuiContext Context{ &ImGuiSubsystem, ImVec2(1920.f, 1080.f) };
+
+	Ar.Logf(TEXT("ImGui occlusion culling benchmark (%d stacked windows):"), WindowCount);
+
+	// only opaque backgrounds occlude, the dark style window background is slightly translucent so the default style shouldn't cull (nor pay for culling)
+	const float DefaultWindowBgAlpha = ImGui::GetStyle().Colors[ImGuiCol_WindowBg].w;
+	for (const bool bOpaqueBackgrounds : { false, true })
+	{
+		ImGui::GetStyle().Colors[ImGuiCol_WindowBg].w = bOpaqueBackgrounds ? 1.f : DefaultWindowBgAlpha;
+
+		// stacked debug windows, each one slightly offset from the previous one
+		// NOTE: first frame bakes the glyphs
+		for (int32 FrameIndex = 0; FrameIndex < 2; ++FrameIndex)
+		{
+			ImGui::NewFrame();
+			for (int32 WindowIndex = 0; WindowIndex < WindowCount; ++WindowIndex)
+			{
+				const float Offset = (WindowIndex % 8) * 4.f;
+				ImGui::SetNextWindowPos(ImVec2(100.f + Offset, 100.f + Offset));
+				ImGui::SetNextWindowSize(ImVec2(800.f, 600.f));
+				ImGui::Begin(TCHAR_TO_UTF8(*FString::Printf(TEXT("Stats %d"), WindowIndex)), nullptr, ImGuiWindowFlags_NoSavedSettings);
+				for (int32 LineIndex = 0; LineIndex < 30; ++LineIndex)
+				{
+					ImGui::Text("STAT_%d_%d: %.3f ms (%d calls)", WindowIndex, LineIndex, LineIndex * 0.017f, LineIndex * 7);
+				}
+				ImGui::End();
+			}
+			ImGui::Render();
+		}
+		const ImDrawData* DrawData = ImGui::GetDrawData();
+
+		ImGuiUtils::FImGuiOcclusionCulling OcclusionCulling;
+		int32 NumCulled = 0;
+		const double BuildTime = FImGuiBenchmarkCommand::Measure([&]() { NumCulled = OcclusionCulling.Build(DrawData); });
+
+		int32 NumCulledVertices = 0;
+		for (int32 ListIndex = 0; ListIndex < DrawData->CmdListsCount; ++ListIndex)
+		{
+			NumCulledVertices += OcclusionCulling.IsCulled(ListIndex) ? DrawData->CmdLists[ListIndex]->VtxBuffer.Size : 0;
+		}
+		const int32 NumDrawLists = DrawData->CmdListsCount;
+		const int32 NumVertices = DrawData->TotalVtxCount;
+
+		Ar.Logf(TEXT("  WindowBg alpha %.2f%s:"), ImGui::GetStyle().Colors[ImGuiCol_WindowBg].w, bOpaqueBackgrounds ? TEXT("") : TEXT(" (default style)"));
+		Ar.Logf(TEXT("    draw lists : %d, culled %d"), NumDrawLists, NumCulled);
+		Ar.Logf(TEXT("    vertices   : %d, culled %d (%.1f%%)"), NumVertices, NumCulledVertices, NumVertices > 0 ? 100.0 * NumCulledVertices / NumVertices : 0.0);
+		Ar.Logf(TEXT("    build %.3f ms"), BuildTime * 1000.0);
+	}
+}
+
+static FImGuiBenchmarkCommand CmdBenchmarkOcclusionCulling(
+	TEXT("OcclusionCulling"),
+	TEXT("Draws stacked windows in an offscreen ImGui context and reports the draw lists/vertices culled behind them, with the default style and with opaque window backgrounds."),
+	TEXT("Windows"), 20, 2, 1000,
+	&BenchmarkOcclusionCulling);
@@ -0,0 +1,33 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#pragma once
+
+#include "ImGuiPluginTypes.h"
+
+class UImGuiSubsystem;
+
+// context pool access outside of the widgets translation unit (see ImGuiContextPool.inl), used by the `imgui.Benchmark.*` commands
+// NOTE: defined in SImGuiWidgets.cpp, the pool itself is local to that translation unit
+namespace ImGuiUtils
+{
+	struct FPooledImGuiContext;
+
+	// number of pre-warmed contexts waiting to be picked up by new widgets
+	int32 GetNumFreePooledContexts();
+
+	// offscreen context made current for the lifetime of the scope, nothing is rendered
+	// NOTE: the context is destroyed instead of being recycled, previous contexts are restored afterwards
+	class FScopedOffscreenImGuiContext : FNoncopyable
+	{
+	public:
+		explicit FScopedOffscreenImGuiContext(UImGuiSubsystem* ImGuiSubsystem, const ImVec2& DisplaySize = ImVec2(1280.f, 720.f));
+		~FScopedOffscreenImGuiContext();
+
+		ImGuiContext* GetContext() const;
+
+	private:
+		TUniquePtr<FPooledImGuiContext> Context;
+		ImGuiContext* PrevImGuiContext = nullptr;
+		ImPlotContext* PrevImPlotContext = nullptr;
+	};
+}
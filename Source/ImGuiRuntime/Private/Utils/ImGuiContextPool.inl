@@ -0,0 +1,283 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#include "GenericPlatform/GenericApplication.h"
+
+static TAutoConsoleVariable<int32> CVarContextPoolSize(
+	TEXT("imgui.ContextPoolSize"),
+	2,
+	TEXT("Number of pre-warmed ImGui contexts kept around for spawning widgets (0 disables pooling)."));
+
+namespace ImGuiUtils
+{
+	// monitor list shared by all contexts, only rebuilt when platform display metrics change
+	class FImGuiMonitorCache
+	{
+	public:
+		FImGuiMonitorCache()
+		{
+			UImGuiSubsystem::OnShutdown.AddRaw(this, &FImGuiMonitorCache::UnregisterDisplayMetricsEvents);
+		}
+
+		const ImVector<ImGuiPlatformMonitor>& GetMonitors()
+		{
+			if (SerialNumber == 0)
+			{
+				FDisplayMetrics DisplayMetrics;
+				FDisplayMetrics::RebuildDisplayMetrics(DisplayMetrics);
+				RebuildMonitors(DisplayMetrics);
+
+				if (FSlateApplication::IsInitialized() && !DisplayMetricsChangedHandle.IsValid())
+				{
+					DisplayMetricsChangedHandle = FSlateApplication::Get().GetPlatformApplication()->OnDisplayMetricsChanged().AddRaw(this, &FImGuiMonitorCache::RebuildMonitors);
+				}
+			}
+			return Monitors;
+		}
+
+		// incremented every time the monitor list changes, 0 means the list hasn't been built yet
+		uint32 GetSerialNumber() const { return SerialNumber; }
+
+		// monitor list with the host rect as an extra (first) monitor, ImGui places and sizes popups within the monitor under the mouse
+		// so popups opened over the widget stay in its viewport and are drawn in the widget's own pass
+		// NOTE: popups are clamped to the monitor work rect, anything larger than the widget is squeezed/scrolled into it (see `imgui.Viewports.HostPopups`)
+		// NOTE: FindPlatformMonitorForPos returns the first match, host is always at index 0 to keep monitor indices stable
+		void BuildHostedMonitors(const ImVec2& HostPos, const ImVec2& HostSize, ImVector<ImGuiPlatformMonitor>& OutMonitors)
+		{
+			const ImVector<ImGuiPlatformMonitor>& PlatformMonitors = GetMonitors();
+
+			ImGuiPlatformMonitor HostMonitor;
+			HostMonitor.MainPos = HostMonitor.WorkPos = HostPos;
+			HostMonitor.MainSize = HostMonitor.WorkSize = HostSize;
+			HostMonitor.PlatformHandle = nullptr;
+
+			// DPI of the platform monitor showing most of the host
+			float BestOverlapArea = -1.f;
+			for (const ImGuiPlatformMonitor& Monitor : PlatformMonitors)
+			{
+				ImRect Overlap(HostPos, HostPos + HostSize);
+				Overlap.ClipWithFull(ImRect(Monitor.MainPos, Monitor.MainPos + Monitor.MainSize));
+				const float OverlapArea = Overlap.GetWidth() * Overlap.GetHeight();
+				if (OverlapArea > BestOverlapArea)
+				{
+					BestOverlapArea = OverlapArea;
+					HostMonitor.DpiScale = Monitor.DpiScale;
+				}
+			}
+
+			OutMonitors.resize(0);
+			OutMonitors.reserve(PlatformMonitors.Size + 1);
+			OutMonitors.push_back(HostMonitor);
+			for (const ImGuiPlatformMonitor& Monitor : PlatformMonitors)
+			{
+				OutMonitors.push_back(Monitor);
+			}
+		}
+
+	private:
+		void RebuildMonitors(const FDisplayMetrics& DisplayMetrics)
+		{
+			Monitors.clear();
+
+			if (DisplayMetrics.MonitorInfo.IsEmpty())
+			{
+				ImGuiPlatformMonitor ImguiMonitor;
+				ImguiMonitor.MainPos = ImVec2(0.f, 0.f);
+				ImguiMonitor.MainSize = ImVec2(DisplayMetrics.PrimaryDisplayWidth, DisplayMetrics.PrimaryDisplayHeight);
+				ImguiMonitor.WorkPos = ImVec2(DisplayMetrics.PrimaryDisplayWorkAreaRect.Left, DisplayMetrics.PrimaryDisplayWorkAreaRect.Top);
+				ImguiMonitor.WorkSize = ImVec2(DisplayMetrics.PrimaryDisplayWorkAreaRect.Right - DisplayMetrics.PrimaryDisplayWorkAreaRect.Left, DisplayMetrics.PrimaryDisplayWorkAreaRect.Bottom - DisplayMetrics.PrimaryDisplayWorkAreaRect.Top);
+				ImguiMonitor.DpiScale = 1.f;
+				ImguiMonitor.PlatformHandle = nullptr;
+
+				Monitors.push_back(ImguiMonitor);
+			}
+			else
+			{
+				for (const FMonitorInfo& MonitorInfo : DisplayMetrics.MonitorInfo)
+				{
+					ImGuiPlatformMonitor ImguiMonitor;
+					ImguiMonitor.MainPos = ImVec2((float)MonitorInfo.DisplayRect.Left, (float)MonitorInfo.DisplayRect.Top);
+					ImguiMonitor.MainSize = ImVec2((float)(MonitorInfo.DisplayRect.Right - MonitorInfo.DisplayRect.Left),
+						(float)(MonitorInfo.DisplayRect.Bottom - MonitorInfo.DisplayRect.Top));
+					ImguiMonitor.WorkPos = ImVec2((float)MonitorInfo.WorkArea.Left, (float)MonitorInfo.WorkArea.Top);
+					ImguiMonitor.WorkSize = ImVec2((float)(MonitorInfo.WorkArea.Right - MonitorInfo.WorkArea.Left),
+						(float)(MonitorInfo.WorkArea.Bottom - MonitorInfo.WorkArea.Top));
+					ImguiMonitor.DpiScale = MonitorInfo.DPI / 96.f;
+					ImguiMonitor.PlatformHandle = nullptr;
+
+					if (MonitorInfo.bIsPrimary)
+					{
+						Monitors.push_front(ImguiMonitor);
+					}
+					else
+					{
+						Monitors.push_back(ImguiMonitor);
+					}
+				}
+			}
+
+			++SerialNumber;
+		}
+
+		void UnregisterDisplayMetricsEvents()
+		{
+			if (DisplayMetricsChangedHandle.IsValid() && FSlateApplication::IsInitialized())
+			{
+				FSlateApplication::Get().GetPlatformApplication()->OnDisplayMetricsChanged().Remove(DisplayMetricsChangedHandle);
+			}
+			DisplayMetricsChangedHandle.Reset();
+		}
+
+		ImVector<ImGuiPlatformMonitor> Monitors;
+		FDelegateHandle DisplayMetricsChangedHandle;
+		uint32 SerialNumber = 0;
+	};
+	static FImGuiMonitorCache MonitorCache;
+
+	// everything a widget needs to run an ImGui context, recycled b/w widgets
+	struct FPooledImGuiContext
+	{
+		ImGuiContext* ImguiContext = nullptr;
+		ImPlotContext* ImplotContext = nullptr;
+		TSharedPtr<FWidgetDrawer> WidgetDrawers[2];
+	};
+
+	class FImGuiContextPool
+	{
+	public:
+		FImGuiContextPool()
+		{
+			UImGuiSubsystem::OnBeginImGuiFrame.AddRaw(this, &FImGuiContextPool::WarmUp);
+			UImGuiSubsystem::OnShutdown.AddRaw(this, &FImGuiContextPool::Shutdown);
+		}
+
+		FPooledImGuiContext AcquireContext(ImFontAtlas* SharedFontAtlas)
+		{
+			if (!FreeContexts.IsEmpty())
+			{
+				return FreeContexts.Pop(EAllowShrinking::No);
+			}
+			return CreateContext(SharedFontAtlas);
+		}
+
+		// NOTE: only call once the render thread is done with the widget drawers (see FDeferredDeletionQueue)
+		void ReleaseContext(FPooledImGuiContext&& Context, bool bForceDestroy)
+		{
+			if (bForceDestroy || bIsShuttingDown || (FreeContexts.Num() >= GetPoolSize()))
+			{
+				DestroyContext(Context);
+			}
+			else
+			{
+				ResetContext(Context);
+				FreeContexts.Add(MoveTemp(Context));
+			}
+		}
+
+		int32 GetNumFreeContexts() const { return FreeContexts.Num(); }
+
+	private:
+		static int32 GetPoolSize()
+		{
+			return FMath::Max(0, CVarContextPoolSize.GetValueOnGameThread());
+		}
+
+		static FPooledImGuiContext CreateContext(ImFontAtlas* SharedFontAtlas)
+		{
+			ImGuiContext* PrevImGuiContext = ImGui::GetCurrentContext();
+			ImPlotContext* PrevImPlotContext = ImPlot::GetCurrentContext();
+
+			FPooledImGuiContext Context;
+			Context.ImguiContext = ImGui::CreateContext(SharedFontAtlas);
+			{
+				FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::ImPlot };
+				Context.ImplotContext = ImPlot::CreateContext();
+			}
+			Context.WidgetDrawers[0] = MakeShared<FWidgetDrawer>();
+			Context.WidgetDrawers[1] = MakeShared<FWidgetDrawer>();
+
+			// create functions make the new context current if none was set
+			ImGui::SetCurrentContext(PrevImGuiContext);
+			ImPlot::SetCurrentContext(PrevImPlotContext);
+
+			return Context;
+		}
+
+		static void ResetContext(FPooledImGuiContext& Context)
+		{
+			ImGuiContext* PrevImGuiContext = ImGui::GetCurrentContext();
+			ImPlotContext* PrevImPlotContext = ImPlot::GetCurrentContext();
+
+			ImGui::SetCurrentContext(Context.ImguiContext);
+			{
+				ImFontAtlas* SharedFontAtlas = Context.ImguiContext->IO.Fonts;
+
+				// same as DestroyContext + CreateContext, minus the allocation
+				ImGui::DestroyPlatformWindows();
+				ImGui::Shutdown();
+				Context.ImguiContext->~ImGuiContext();
+
+				// the recycled context starts with fresh memory counters and frame arena
+				ImGuiMemory::OnContextDestroyed(Context.ImguiContext);
+
+				IM_PLACEMENT_NEW(Context.ImguiContext) ImGuiContext(SharedFontAtlas);
+				ImGui::Initialize();
+			}
+			ImGui::SetCurrentContext(PrevImGuiContext);
+
+			{
+				FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::ImPlot };
+				Context.ImplotContext->~ImPlotContext();
+				IM_PLACEMENT_NEW(Context.ImplotContext) ImPlotContext();
+				ImPlot::Initialize(Context.ImplotContext);
+			}
+			ImPlot::SetCurrentContext(PrevImPlotContext);
+		}
+
+		static void DestroyContext(FPooledImGuiContext& Context)
+		{
+			ImPlot::DestroyContext(Context.ImplotContext);
+
+			ImGui::SetCurrentContext(Context.ImguiContext);
+			{
+				ImGui::DestroyPlatformWindows();
+				ImGui::DestroyContext(Context.ImguiContext);
+			}
+			ImGui::SetCurrentContext(nullptr);
+			ImGuiMemory::OnContextDestroyed(Context.ImguiContext);
+
+			Context = {};
+		}
+
+		void WarmUp()
+		{
+			if (bIsShuttingDown || (FreeContexts.Num() >= GetPoolSize()))
+			{
+				return;
+			}
+
+			// atmost one context per frame to spread the cost
+			// NOTE: nothing is warmed up until the first widget loads the fonts (see `imgui.LazyInitialization`)
+			UImGuiSubsystem* ImGuiSubsystem = UImGuiSubsystem::Get();
+			if (ImGuiSubsystem && ImGuiSubsystem->AreFontsLoaded())
+			{
+				FreeContexts.Add(CreateContext(ImGuiSubsystem->GetSharedFontAtlas()));
+			}
+		}
+
+		void Shutdown()
+		{
+			bIsShuttingDown = true;
+
+			// contexts hold a reference to the shared font atlas, release them before the subsystem goes away
+			for (FPooledImGuiContext& Context : FreeContexts)
+			{
+				DestroyContext(Context);
+			}
+			FreeContexts.Reset();
+		}
+
+		TArray<FPooledImGuiContext> FreeContexts;
+		bool bIsShuttingDown = false;
+	};
+	static FImGuiContextPool ContextPool;
+}
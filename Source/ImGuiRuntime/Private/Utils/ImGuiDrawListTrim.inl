@@ -0,0 +1,224 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#if IMGUI_ALLOW_LOCAL_DRAWING
+
+#include "imgui/misc/imgui_threaded_rendering.h"
+
+static TAutoConsoleVariable<int32> CVarTrimDrawBufferFrames(
+	TEXT("imgui.Memory.TrimFrames"),
+	300,
+	TEXT("Number of consecutive frames a draw buffer has to stay below imgui.Memory.TrimUsagePercent of its capacity before it is shrunk (0 disables trimming)."));
+
+static TAutoConsoleVariable<float> CVarTrimDrawBufferUsagePercent(
+	TEXT("imgui.Memory.TrimUsagePercent"),
+	25.f,
+	TEXT("Usage (in percent of capacity) below which a draw buffer is considered oversized, see imgui.Memory.TrimFrames."));
+
+DECLARE_MEMORY_STAT(TEXT("Reclaimed Draw Memory"), STAT_ImGui_ReclaimedDrawMemory, STATGROUP_ImGui);
+
+namespace ImGuiUtils
+{
+	struct FDrawBufferTrimPolicy
+	{
+		static FDrawBufferTrimPolicy Get()
+		{
+			FDrawBufferTrimPolicy Policy;
+			Policy.NumFrames = FMath::Max(0, CVarTrimDrawBufferFrames.GetValueOnGameThread());
+			Policy.UsageRatio = FMath::Clamp(CVarTrimDrawBufferUsagePercent.GetValueOnGameThread() / 100.f, 0.f, 1.f);
+			return Policy;
+		}
+
+		bool IsEnabled() const { return NumFrames > 0 && UsageRatio > 0.f; }
+
+		// small buffers are not worth the reallocation
+		static constexpr SIZE_T MinBufferBytes = 64 * 1024;
+
+		int32 NumFrames = 0;
+		float UsageRatio = 0.f;
+	};
+
+	// usage history of a growable buffer, buffers are shrunk once usage stayed low for `NumFrames` frames
+	struct FDrawBufferTrimState
+	{
+		// call once per frame with the number of elements used this frame
+		void Update(int32 Size, int32 Capacity, const FDrawBufferTrimPolicy& Policy)
+		{
+			// usage grew back, let the buffers keep their size
+			if (Size > TrimCapacity)
+			{
+				TrimCapacity = 0;
+			}
+
+			if (Size <= Capacity * Policy.UsageRatio)
+			{
+				PeakSize = FMath::Max(PeakSize, Size);
+				if (++FramesBelowThreshold >= Policy.NumFrames)
+				{
+					// same growth factor as ImVector, so steady usage doesn't reallocate right away
+					TrimCapacity = FMath::Max(PeakSize + PeakSize / 2, 1);
+					FramesBelowThreshold = 0;
+					PeakSize = 0;
+				}
+			}
+			else
+			{
+				FramesBelowThreshold = 0;
+				PeakSize = 0;
+			}
+		}
+
+		// NOTE: buffers rotate b/w draw lists and snapshots, so the target capacity is kept around until usage grows again
+		bool ShouldTrim(int32 Capacity, SIZE_T ElementSize, const FDrawBufferTrimPolicy& Policy) const
+		{
+			return TrimCapacity > 0 &&
+				TrimCapacity <= Capacity * Policy.UsageRatio &&
+				Capacity * ElementSize >= FDrawBufferTrimPolicy::MinBufferBytes;
+		}
+
+		int32 FramesBelowThreshold = 0;
+		int32 PeakSize = 0;
+		int32 TrimCapacity = 0;
+	};
+
+	// returns reclaimed bytes
+	template<typename T>
+	static SIZE_T TrimBuffer(ImVector<T>& Vector, int32 NewCapacity)
+	{
+		NewCapacity = FMath::Max(NewCapacity, Vector.Size);
+		if (NewCapacity >= Vector.Capacity)
+		{
+			return 0;
+		}
+
+		const SIZE_T ReclaimedBytes = (Vector.Capacity - NewCapacity) * sizeof(T);
+
+		ImVector<T> TrimmedVector;
+		TrimmedVector.reserve(NewCapacity);
+		TrimmedVector.resize(Vector.Size);
+		if (Vector.Size > 0)
+		{
+			FMemory::Memcpy(TrimmedVector.Data, Vector.Data, Vector.Size * sizeof(T));
+		}
+		Vector.swap(TrimmedVector);
+
+		return ReclaimedBytes;
+	}
+
+	template<typename T>
+	static SIZE_T TrimBuffer(TArray<T>& Array, int32 NewCapacity)
+	{
+		NewCapacity = FMath::Max(NewCapacity, Array.Num());
+		if (NewCapacity >= Array.Max())
+		{
+			return 0;
+		}
+
+		const SIZE_T PrevAllocatedSize = Array.GetAllocatedSize();
+
+		TArray<T> TrimmedArray;
+		TrimmedArray.Reserve(NewCapacity);
+		TrimmedArray.Append(Array);
+		Array = MoveTemp(TrimmedArray);
+
+		return PrevAllocatedSize - Array.GetAllocatedSize();
+	}
+
+	// shrinks ImGui draw lists (and their snapshot copies) that have been oversized for a while
+	// NOTE: game thread only
+	class FDrawListTrimmer
+	{
+	public:
+		// NOTE: call before the draw data is snapshotted, buffers are only touched on the game thread while the render thread isn't using them
+		void Trim(const ImDrawData* DrawData, ImDrawDataSnapshot* Snapshot)
+		{
+			const FDrawBufferTrimPolicy Policy = FDrawBufferTrimPolicy::Get();
+			if (!Policy.IsEnabled())
+			{
+				if (!DrawListStates.IsEmpty())
+				{
+					DrawListStates.Reset();
+				}
+				return;
+			}
+
+			SIZE_T ReclaimedBytes = 0;
+			for (ImDrawList* DrawList : DrawData->CmdLists)
+			{
+				ImDrawList* SnapshotDrawList = nullptr;
+				if (Snapshot)
+				{
+					if (ImDrawDataSnapshotEntry* SnapshotEntry = Snapshot->Cache.GetByKey(Snapshot->GetDrawListID(DrawList)))
+					{
+						SnapshotDrawList = SnapshotEntry->OurCopy;
+					}
+				}
+
+				FDrawListTrimState& State = DrawListStates.FindOrAdd(DrawList);
+				// widgets can be painted more than once per frame, only sample usage once
+				if (State.LastUpdateFrame != GFrameCounter)
+				{
+					State.LastUpdateFrame = GFrameCounter;
+					State.Vertices.Update(DrawList->VtxBuffer.Size, FMath::Max(DrawList->VtxBuffer.Capacity, SnapshotDrawList ? SnapshotDrawList->VtxBuffer.Capacity : 0), Policy);
+					State.Indices.Update(DrawList->IdxBuffer.Size, FMath::Max(DrawList->IdxBuffer.Capacity, SnapshotDrawList ? SnapshotDrawList->IdxBuffer.Capacity : 0), Policy);
+				}
+
+				{
+					FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::DrawLists };
+					ReclaimedBytes += TrimDrawList(*DrawList, State, Policy);
+				}
+				if (SnapshotDrawList)
+				{
+					// snapshot swaps buffers with the source list and reserves its capacity, trim both or nothing is reclaimed
+					FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::Snapshots };
+					ReclaimedBytes += TrimDrawList(*SnapshotDrawList, State, Policy);
+				}
+			}
+
+			if (ReclaimedBytes > 0)
+			{
+				INC_MEMORY_STAT_BY(STAT_ImGui_ReclaimedDrawMemory, ReclaimedBytes);
+			}
+
+			// forget draw lists that haven't been drawn for a while (closed windows etc..)
+			if (GFrameCounter - LastPruneFrame > (uint64)Policy.NumFrames)
+			{
+				LastPruneFrame = GFrameCounter;
+				for (auto It = DrawListStates.CreateIterator(); It; ++It)
+				{
+					if (GFrameCounter - It.Value().LastUpdateFrame > (uint64)Policy.NumFrames)
+					{
+						It.RemoveCurrent();
+					}
+				}
+			}
+		}
+
+	private:
+		struct FDrawListTrimState
+		{
+			FDrawBufferTrimState Vertices;
+			FDrawBufferTrimState Indices;
+			uint64 LastUpdateFrame = 0;
+		};
+
+		static SIZE_T TrimDrawList(ImDrawList& DrawList, const FDrawListTrimState& State, const FDrawBufferTrimPolicy& Policy)
+		{
+			SIZE_T ReclaimedBytes = 0;
+			if (State.Vertices.ShouldTrim(DrawList.VtxBuffer.Capacity, sizeof(ImDrawVert), Policy))
+			{
+				ReclaimedBytes += TrimBuffer(DrawList.VtxBuffer, State.Vertices.TrimCapacity);
+			}
+			if (State.Indices.ShouldTrim(DrawList.IdxBuffer.Capacity, sizeof(ImDrawIdx), Policy))
+			{
+				ReclaimedBytes += TrimBuffer(DrawList.IdxBuffer, State.Indices.TrimCapacity);
+			}
+			return ReclaimedBytes;
+		}
+
+		TMap<const ImDrawList*, FDrawListTrimState> DrawListStates;
+		uint64 LastPruneFrame = 0;
+	};
+	static FDrawListTrimmer DrawListTrimmer;
+}
+
+#endif //#if IMGUI_ALLOW_LOCAL_DRAWING
@@ -14,6 +14,32 @@
 #include "Rendering/RenderingCommon.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "imgui/misc/imgui_threaded_rendering.h"
+#include "Utils/ImGuiGlyphInstances.h"
+#include "Utils/ImGuiOcclusionCulling.h"
+#endif
+
+#if WITH_ENGINE
+static TAutoConsoleVariable<bool> CVarGpuWindowScopes(
+	TEXT("imgui.GPU.WindowScopes"),
+	false,
+	TEXT("Add a GPU event scope for each ImGui window when rendering widgets (visible in ProfileGPU/Insights)."));
+
+static TAutoConsoleVariable<bool> CVarGlyphInstancing(
+	TEXT("imgui.GlyphInstancing"),
+	true,
+	TEXT("Draw runs of glyph quads as instances (position, glyph rect index and color) expanded in the vertex shader, instead of uploading 4 vertices + 6 indices per glyph."));
+
+static TAutoConsoleVariable<int32> CVarGlyphInstancingMinRunLength(
+	TEXT("imgui.GlyphInstancing.MinRunLength"),
+	8,
+	TEXT("Minimum number of consecutive glyph quads in a draw command to draw them instanced, shorter runs stay indexed (each run is a separate draw call)."));
+
+static TAutoConsoleVariable<bool> CVarOcclusionCulling(
+	TEXT("imgui.OcclusionCulling"),
+	true,
+	TEXT("Skip uploading/drawing the draw lists completely covered by opaque windows drawn after them (stacked or docked windows), free when no window background is opaque (default dark style)."));
+
+DECLARE_GPU_STAT_NAMED(ImGui, TEXT("ImGui"));
 #endif
 
 namespace ImGuiUtils
@@ -70,15 +96,44 @@ namespace ImGuiUtils
 
 		bool SetDrawData(ImDrawData* DrawData, double CurrentTime, FVector2f DrawRectOffset)
 		{
-			m_DrawDataSnapshot.SnapUsingSwap(DrawData, CurrentTime);
+			DrawListTrimmer.Trim(DrawData, &m_DrawDataSnapshot);
+
+			// window state is needed to find the occluders, so lists are culled before the snapshot and removed from it after
+			const bool bOcclusionCulling = CVarOcclusionCulling.GetValueOnGameThread() && m_OcclusionCulling.Build(DrawData) > 0;
+			{
+				FImGuiMemoryScope MemoryScope{ EImGuiMemoryCategory::Snapshots };
+				m_DrawDataSnapshot.SnapUsingSwap(DrawData, CurrentTime);
+			}
 			DrawData = &m_DrawDataSnapshot.DrawData;
+			if (bOcclusionCulling)
+			{
+				m_OcclusionCulling.RemoveCulled(DrawData);
+			}
 
 			m_DrawRectOffset = DrawRectOffset;
 
+			if (const ImGuiContext* Context = ImGui::GetCurrentContext())
+			{
+				m_ContextName = (Context->ContextName[0] != 0) ? UTF8_TO_TCHAR(Context->ContextName) : TEXT("Unnamed");
+			}
+
+			// window names are only valid on the game thread, copy them for the render thread event scopes
+			m_DrawListNames.Reset();
+			if (CVarGpuWindowScopes.GetValueOnGameThread())
+			{
+				for (const ImDrawList* CmdList : DrawData->CmdLists)
+				{
+					m_DrawListNames.Emplace(CmdList->_OwnerName ? UTF8_TO_TCHAR(CmdList->_OwnerName) : TEXT("Unknown"));
+				}
+			}
+
 			UImGuiSubsystem* ImGuiSubsystem = UImGuiSubsystem::Get();
 			ImGuiSubsystem->UpdateFontAtlasTextures(DrawData->Textures->Data, DrawData->Textures->Size);
 			m_BoundTextureResources.Reset(ImGuiSubsystem->GetOneFrameResources().Num());
 
+			m_bInstanceGlyphs = CVarGlyphInstancing.GetValueOnGameThread();
+			m_GlyphInstancingMinRunLength = CVarGlyphInstancingMinRunLength.GetValueOnGameThread();
+
 			m_bHasDrawCommands = DrawData->TotalVtxCount > 0 &&
 				DrawData->TotalIdxCount > 0 &&
 				(DrawData->DisplaySize.x > KINDA_SMALL_NUMBER) &&
@@ -88,9 +143,10 @@ namespace ImGuiUtils
 				return false;
 			}
 
-			for (const FImGuiTextureResource& TextureResource : ImGuiSubsystem->GetOneFrameResources())
+			const TArray<FImGuiTextureResource>& OneFrameResources = ImGuiSubsystem->GetOneFrameResources();
+			for (int32 TextureIndex = 0; TextureIndex < OneFrameResources.Num(); ++TextureIndex)
 			{
-				m_BoundTextureResources.Emplace(TextureResource, TextureResource.GetSlateShaderResource());
+				m_BoundTextureResources.Emplace(OneFrameResources[TextureIndex], OneFrameResources[TextureIndex].GetSlateShaderResource(), ImGuiSubsystem->IsSdfFontTexture(TextureIndex));
 			}
 
 			m_bCaptureGpuFrame = ImGuiSubsystem->CaptureGpuFrame();
@@ -113,7 +169,8 @@ namespace ImGuiUtils
 			FRenderParameters* PassParameters = GraphBuilder.AllocParameters<FRenderParameters>();
 			PassParameters->RenderTargets[0] = FRenderTargetBinding(Inputs.OutputTexture, ERenderTargetLoadAction::ELoad);
 
-			GraphBuilder.AddPass(RDG_EVENT_NAME("RenderImGui"), PassParameters, ERDGPassFlags::Raster | ERDGPassFlags::NeverCull,
+			RDG_GPU_STAT_SCOPE(GraphBuilder, ImGui);
+			GraphBuilder.AddPass(RDG_EVENT_NAME("RenderImGui %s", *m_ContextName), PassParameters, ERDGPassFlags::Raster | ERDGPassFlags::NeverCull,
 				[this](FRHICommandListImmediate& RHICmdList)
 				{
 					DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Render Widget [RT]"), STAT_ImGui_RenderWidget_RT, STATGROUP_ImGui);
@@ -136,6 +193,7 @@ namespace ImGuiUtils
 					for (const auto& TextureResourceInfo : m_BoundTextureResources)
 					{
 						auto& BoundTexture = m_BoundTextures.AddDefaulted_GetRef();
+						BoundTexture.IsSdfFont = TextureResourceInfo.IsSdfFont;
 
 						FSlateShaderResource* ShaderResource = TextureResourceInfo.ExpectedSlateResource;
 
@@ -203,52 +261,120 @@ namespace ImGuiUtils
 					FallbackTexture.TextureRHI = GWhiteTexture->TextureRHI;
 					FallbackTexture.SamplerRHI = TStaticSamplerState<SF_Point>::GetRHI();
 
+					// glyph quads are drawn instanced, the rest is uploaded as indexed triangles
+					m_GlyphInstances.Build(DrawData, m_bInstanceGlyphs, m_GlyphInstancingMinRunLength);
+					const uint32 NumVertices = FMath::Max(m_GlyphInstances.GetNumVertices(), 1u);
+					const uint32 NumIndices = FMath::Max(m_GlyphInstances.GetNumIndices(), 1u);
+					const uint32 NumGlyphInstances = m_GlyphInstances.GetInstances().Num();
+					const uint32 NumGlyphRects = m_GlyphInstances.GetRects().Num();
+
 #if ((ENGINE_MAJOR_VERSION * 100u + ENGINE_MINOR_VERSION) > 505) //(Version > 5.5)
 					FRHIBufferCreateDesc VertexBufferDesc =
-						FRHIBufferCreateDesc::CreateVertex<ImDrawVert>(TEXT("ImGui_VertexBuffer"), DrawData->TotalVtxCount)
+						FRHIBufferCreateDesc::CreateVertex<ImDrawVert>(TEXT("ImGui_VertexBuffer"), NumVertices)
 						.AddUsage(EBufferUsageFlags::Volatile | EBufferUsageFlags::VertexBuffer)
 						.SetInitialState(ERHIAccess::VertexOrIndexBuffer)
 						.SetInitActionNone();
 					FBufferRHIRef VertexBuffer = RHICmdList.CreateBuffer(VertexBufferDesc);
 
 					FRHIBufferCreateDesc IndexBufferDesc =
-						FRHIBufferCreateDesc::CreateIndex<ImDrawIdx>(TEXT("ImGui_IndexBuffer"), DrawData->TotalIdxCount)
+						FRHIBufferCreateDesc::CreateIndex<ImDrawIdx>(TEXT("ImGui_IndexBuffer"), NumIndices)
 						.AddUsage(EBufferUsageFlags::Volatile | EBufferUsageFlags::IndexBuffer)
 						.SetInitialState(ERHIAccess::VertexOrIndexBuffer)
 						.SetInitActionNone();
 					FBufferRHIRef IndexBuffer = RHICmdList.CreateBuffer(IndexBufferDesc);
+
+					FBufferRHIRef GlyphInstanceBuffer, GlyphRectBuffer;
+					if (NumGlyphInstances > 0)
+					{
+						FRHIBufferCreateDesc GlyphInstanceBufferDesc =
+							FRHIBufferCreateDesc::CreateVertex<FImGuiGlyphInstances::FGlyphInstance>(TEXT("ImGui_GlyphInstanceBuffer"), NumGlyphInstances)
+							.AddUsage(EBufferUsageFlags::Volatile | EBufferUsageFlags::ShaderResource)
+							.SetInitialState(ERHIAccess::SRVGraphics)
+							.SetInitActionNone();
+						GlyphInstanceBuffer = RHICmdList.CreateBuffer(GlyphInstanceBufferDesc);
+
+						FRHIBufferCreateDesc GlyphRectBufferDesc =
+							FRHIBufferCreateDesc::CreateVertex<FImGuiGlyphInstances::FGlyphRect>(TEXT("ImGui_GlyphRectBuffer"), NumGlyphRects)
+							.AddUsage(EBufferUsageFlags::Volatile | EBufferUsageFlags::ShaderResource)
+							.SetInitialState(ERHIAccess::SRVGraphics)
+							.SetInitActionNone();
+						GlyphRectBuffer = RHICmdList.CreateBuffer(GlyphRectBufferDesc);
+					}
 #else
 					FRHIResourceCreateInfo VertexBufferCreateInfo(TEXT("ImGui_VertexBuffer"));
 					FBufferRHIRef VertexBuffer = RHICmdList.CreateBuffer(
-						DrawData->TotalVtxCount * sizeof(ImDrawVert), EBufferUsageFlags::Volatile | EBufferUsageFlags::VertexBuffer,
+						NumVertices * sizeof(ImDrawVert), EBufferUsageFlags::Volatile | EBufferUsageFlags::VertexBuffer,
 						sizeof(ImDrawVert), ERHIAccess::VertexOrIndexBuffer, VertexBufferCreateInfo);
 
 					FRHIResourceCreateInfo IndexBufferCreateInfo(TEXT("ImGui_IndexBuffer"));
 					FBufferRHIRef IndexBuffer = RHICmdList.CreateBuffer(
-						DrawData->TotalIdxCount * sizeof(ImDrawIdx), EBufferUsageFlags::Volatile | EBufferUsageFlags::IndexBuffer,
+						NumIndices * sizeof(ImDrawIdx), EBufferUsageFlags::Volatile | EBufferUsageFlags::IndexBuffer,
 						sizeof(ImDrawIdx), ERHIAccess::VertexOrIndexBuffer, IndexBufferCreateInfo);
+
+					FBufferRHIRef GlyphInstanceBuffer, GlyphRectBuffer;
+					if (NumGlyphInstances > 0)
+					{
+						FRHIResourceCreateInfo GlyphInstanceBufferCreateInfo(TEXT("ImGui_GlyphInstanceBuffer"));
+						GlyphInstanceBuffer = RHICmdList.CreateBuffer(
+							NumGlyphInstances * sizeof(FImGuiGlyphInstances::FGlyphInstance), EBufferUsageFlags::Volatile | EBufferUsageFlags::VertexBuffer | EBufferUsageFlags::ShaderResource,
+							sizeof(FImGuiGlyphInstances::FGlyphInstance), ERHIAccess::SRVGraphics, GlyphInstanceBufferCreateInfo);
+
+						FRHIResourceCreateInfo GlyphRectBufferCreateInfo(TEXT("ImGui_GlyphRectBuffer"));
+						GlyphRectBuffer = RHICmdList.CreateBuffer(
+							NumGlyphRects * sizeof(FImGuiGlyphInstances::FGlyphRect), EBufferUsageFlags::Volatile | EBufferUsageFlags::VertexBuffer | EBufferUsageFlags::ShaderResource,
+							sizeof(FImGuiGlyphInstances::FGlyphRect), ERHIAccess::SRVGraphics, GlyphRectBufferCreateInfo);
+					}
 #endif
 
-					ImDrawVert* VertexDst = (ImDrawVert*)RHICmdList.LockBuffer(VertexBuffer, 0u, DrawData->TotalVtxCount * sizeof(ImDrawVert), RLM_WriteOnly);
-					ImDrawIdx* IndexDst = (ImDrawIdx*)RHICmdList.LockBuffer(IndexBuffer, 0u, DrawData->TotalIdxCount * sizeof(ImDrawIdx), RLM_WriteOnly);
-					if (ensure(VertexDst && IndexDst))
+					FShaderResourceViewRHIRef GlyphInstanceSRV, GlyphRectSRV;
+					if (NumGlyphInstances > 0)
 					{
-						for (const ImDrawList* CmdList : DrawData->CmdLists)
-						{
-							FMemory::Memcpy(VertexDst, CmdList->VtxBuffer.Data, CmdList->VtxBuffer.Size * sizeof(ImDrawVert));
-							FMemory::Memcpy(IndexDst, CmdList->IdxBuffer.Data, CmdList->IdxBuffer.Size * sizeof(ImDrawIdx));
+						void* GlyphInstanceDst = RHICmdList.LockBuffer(GlyphInstanceBuffer, 0u, NumGlyphInstances * sizeof(FImGuiGlyphInstances::FGlyphInstance), RLM_WriteOnly);
+						FMemory::Memcpy(GlyphInstanceDst, m_GlyphInstances.GetInstances().GetData(), NumGlyphInstances * sizeof(FImGuiGlyphInstances::FGlyphInstance));
+						RHICmdList.UnlockBuffer(GlyphInstanceBuffer);
 
-							VertexDst += CmdList->VtxBuffer.Size;
-							IndexDst += CmdList->IdxBuffer.Size;
-						}
+						void* GlyphRectDst = RHICmdList.LockBuffer(GlyphRectBuffer, 0u, NumGlyphRects * sizeof(FImGuiGlyphInstances::FGlyphRect), RLM_WriteOnly);
+						FMemory::Memcpy(GlyphRectDst, m_GlyphInstances.GetRects().GetData(), NumGlyphRects * sizeof(FImGuiGlyphInstances::FGlyphRect));
+						RHICmdList.UnlockBuffer(GlyphRectBuffer);
+
+						GlyphInstanceSRV = RHICmdList.CreateShaderResourceView(GlyphInstanceBuffer, FRHIViewDesc::CreateBufferSRV().SetType(FRHIViewDesc::EBufferType::Typed).SetFormat(PF_R32G32B32A32_UINT));
+						GlyphRectSRV = RHICmdList.CreateShaderResourceView(GlyphRectBuffer, FRHIViewDesc::CreateBufferSRV().SetType(FRHIViewDesc::EBufferType::Typed).SetFormat(PF_A32B32G32R32F));
+					}
+
+					ImDrawVert* VertexDst = (ImDrawVert*)RHICmdList.LockBuffer(VertexBuffer, 0u, NumVertices * sizeof(ImDrawVert), RLM_WriteOnly);
+					ImDrawIdx* IndexDst = (ImDrawIdx*)RHICmdList.LockBuffer(IndexBuffer, 0u, NumIndices * sizeof(ImDrawIdx), RLM_WriteOnly);
+					if (ensure(VertexDst && IndexDst))
+					{
+						m_GlyphInstances.WriteVertices(DrawData, VertexDst);
+						m_GlyphInstances.WriteIndices(DrawData, IndexDst);
 						RHICmdList.UnlockBuffer(VertexBuffer);
 						RHICmdList.UnlockBuffer(IndexBuffer);
 					}
 
 					{
 						TShaderMapRef<FImGuiVS> VertexShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+
+						FImGuiVS::FPermutationDomain GlyphInstancesPermutationVector;
+						GlyphInstancesPermutationVector.Set<FImGuiVS::FGlyphInstances>(true);
+						TShaderMapRef<FImGuiVS> GlyphInstancesVertexShader(GetGlobalShaderMap(GMaxRHIFeatureLevel), GlyphInstancesPermutationVector);
+						bool bGlyphInstancesVertexShaderBound = false;
 						TShaderMapRef<FImGuiPS> PixelShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
 
+						FImGuiPS::FPermutationDomain SdfFontPermutationVector;
+						SdfFontPermutationVector.Set<FImGuiPS::FSdfFont>(true);
+						TShaderMapRef<FImGuiPS> SdfFontPixelShader(GetGlobalShaderMap(GMaxRHIFeatureLevel), SdfFontPermutationVector);
+						bool bSdfFontPixelShaderBound = false;
+
+						// ImGuiShapes quads, enabled/disabled with ImDrawCallback_SetShapeRendering
+						FImGuiVS::FPermutationDomain SdfShapesVertexPermutationVector;
+						SdfShapesVertexPermutationVector.Set<FImGuiVS::FSdfShapes>(true);
+						TShaderMapRef<FImGuiVS> SdfShapesVertexShader(GetGlobalShaderMap(GMaxRHIFeatureLevel), SdfShapesVertexPermutationVector);
+						FImGuiPS::FPermutationDomain SdfShapesPixelPermutationVector;
+						SdfShapesPixelPermutationVector.Set<FImGuiPS::FSdfShapes>(true);
+						TShaderMapRef<FImGuiPS> SdfShapesPixelShader(GetGlobalShaderMap(GMaxRHIFeatureLevel), SdfShapesPixelPermutationVector);
+						bool bSdfShapesBound = false;
+						bool bSdfShapes = false;
+
 						FGraphicsPipelineStateInitializer GraphicsPSOInit;
 						RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
 						GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
@@ -262,6 +388,28 @@ namespace ImGuiUtils
 
 						RHICmdList.SetStreamSource(0, VertexBuffer, 0);
 
+						// NOTE: shapes are never instanced and don't sample the texture
+						auto SetPipelineState = [&](bool bGlyphInstances, bool bIsSdfFont, bool bIsSdfShape)
+							{
+								if (bGlyphInstances == bGlyphInstancesVertexShaderBound && bIsSdfFont == bSdfFontPixelShaderBound && bIsSdfShape == bSdfShapesBound)
+								{
+									return;
+								}
+								bGlyphInstancesVertexShaderBound = bGlyphInstances;
+								bSdfFontPixelShaderBound = bIsSdfFont;
+								bSdfShapesBound = bIsSdfShape;
+
+								// glyph instances are expanded from SRVs, no vertex input
+								GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = bGlyphInstances ? GEmptyVertexDeclaration.VertexDeclarationRHI : GImGuiVertexDeclaration.VertexDeclarationRHI;
+								GraphicsPSOInit.BoundShaderState.VertexShaderRHI = bGlyphInstances ? GlyphInstancesVertexShader.GetVertexShader() : (bIsSdfShape ? SdfShapesVertexShader.GetVertexShader() : VertexShader.GetVertexShader());
+								GraphicsPSOInit.BoundShaderState.PixelShaderRHI = bIsSdfShape ? SdfShapesPixelShader.GetPixelShader() : (bIsSdfFont ? SdfFontPixelShader.GetPixelShader() : PixelShader.GetPixelShader());
+								SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit, 0);
+								if (!bGlyphInstances)
+								{
+									RHICmdList.SetStreamSource(0, VertexBuffer, 0);
+								}
+							};
+
 						auto CalculateProjectionMatrix = [&]()
 							{
 								const float L = DisplayPos.x;
@@ -286,12 +434,19 @@ namespace ImGuiUtils
 						RHICmdList.SetViewport(ViewportRect.Min.x, ViewportRect.Min.y, 0.f, ViewportRect.Max.x, ViewportRect.Max.y, 1.f);
 						RHICmdList.SetScissorRect(false, 0.f, 0.f, 0.f, 0.f);
 
-						uint32 GlobalVertexOffset = 0;
-						uint32 GlobalIndexOffset = 0;
-						for (const ImDrawList* CmdList : DrawData->CmdLists)
+						int32 CmdIndex = 0;
+						for (int32 CmdListIndex = 0; CmdListIndex < DrawData->CmdLists.Size; ++CmdListIndex)
 						{
+							const ImDrawList* CmdList = DrawData->CmdLists[CmdListIndex];
+							SCOPED_CONDITIONAL_DRAW_EVENTF(RHICmdList, ImGuiWindow, m_DrawListNames.IsValidIndex(CmdListIndex), TEXT("%s"), m_DrawListNames.IsValidIndex(CmdListIndex) ? *m_DrawListNames[CmdListIndex] : TEXT(""));
+
+							// shape rendering callbacks only cover the draw list they were added to
+							bSdfShapes = false;
+
 							for (const ImDrawCmd& DrawCmd : CmdList->CmdBuffer)
 							{
+								const TArrayView<const FImGuiGlyphInstances::FDrawSegment> DrawSegments = m_GlyphInstances.GetCmdSegments(CmdIndex++);
+
 								if (DrawCmd.UserCallback != NULL)
 								{
 									if (DrawCmd.UserCallback == ImDrawCallback_ResetRenderState)
@@ -311,6 +466,10 @@ namespace ImGuiUtils
 									{
 										bForcePointSamplerState = (DrawCmd.UserCallback == ImDrawCallback_SetSamplerStatePoint);
 									}
+									else if (DrawCmd.UserCallback == ImDrawCallback_SetShapeRendering)
+									{
+										bSdfShapes = (DrawCmd.UserCallbackData != nullptr);
+									}
 									else
 									{
 										DrawCmd.UserCallback(RHICmdList, DrawRect, DrawData->OwnerViewport ? DrawData->OwnerViewport->Pos : ImVec2(0.f, 0.f), DrawCmd.UserCallbackData, DrawCmd.UserCallbackDataSize);
@@ -346,24 +505,54 @@ namespace ImGuiUtils
 										TextureIndex = m_BoundTextures.Num() - 1;
 									}
 
-									SetShaderParametersLegacyVS(
-										RHICmdList,
-										VertexShader,
-										ProjectionMatrixParam,
-										m_BoundTextures[TextureIndex].TexCoordOverrideMode);
+									// SDF font atlas textures need the pixel shader resolving the distance field
+									const bool bIsSdfFont = m_BoundTextures[TextureIndex].IsSdfFont && !bSdfShapes;
+									const TShaderMapRef<FImGuiVS>& IndexedVertexShader = bSdfShapes ? SdfShapesVertexShader : VertexShader;
+									const TShaderMapRef<FImGuiPS>& ActivePixelShader = bSdfShapes ? SdfShapesPixelShader : (bIsSdfFont ? SdfFontPixelShader : PixelShader);
 
-									SetShaderParametersLegacyPS(
-										RHICmdList,
-										PixelShader,
-										m_BoundTextures[TextureIndex].TextureRHI,
-										bForcePointSamplerState ? PointSamplerStateRHI : m_BoundTextures[TextureIndex].SamplerRHI.GetReference(),
-										ShaderStateOverrides | (m_BoundTextures[TextureIndex].IsSRGB ? (uint32)EImGuiShaderState::OutputInSRGB : 0));
+									for (const FImGuiGlyphInstances::FDrawSegment& DrawSegment : DrawSegments)
+									{
+										const bool bGlyphInstances = DrawSegment.NumInstances > 0;
+										SetPipelineState(bGlyphInstances, bIsSdfFont, bSdfShapes);
 
-									RHICmdList.DrawIndexedPrimitive(IndexBuffer, DrawCmd.VtxOffset + GlobalVertexOffset, 0, DrawCmd.ElemCount, DrawCmd.IdxOffset + GlobalIndexOffset, DrawCmd.ElemCount / 3, 1);
+										if (bGlyphInstances)
+										{
+											SetShaderParametersLegacyVS(
+												RHICmdList,
+												GlyphInstancesVertexShader,
+												ProjectionMatrixParam,
+												m_BoundTextures[TextureIndex].TexCoordOverrideMode,
+												GlyphInstanceSRV.GetReference(),
+												GlyphRectSRV.GetReference(),
+												DrawSegment.FirstInstance);
+										}
+										else
+										{
+											SetShaderParametersLegacyVS(
+												RHICmdList,
+												IndexedVertexShader,
+												ProjectionMatrixParam,
+												m_BoundTextures[TextureIndex].TexCoordOverrideMode);
+										}
+
+										SetShaderParametersLegacyPS(
+											RHICmdList,
+											ActivePixelShader,
+											m_BoundTextures[TextureIndex].TextureRHI,
+											bForcePointSamplerState ? PointSamplerStateRHI : m_BoundTextures[TextureIndex].SamplerRHI.GetReference(),
+											ShaderStateOverrides | (m_BoundTextures[TextureIndex].IsSRGB ? (uint32)EImGuiShaderState::OutputInSRGB : 0));
+
+										if (bGlyphInstances)
+										{
+											RHICmdList.DrawPrimitive(0, 2, DrawSegment.NumInstances);
+										}
+										else
+										{
+											RHICmdList.DrawIndexedPrimitive(IndexBuffer, DrawSegment.BaseVertex, 0, DrawSegment.NumIndices, DrawSegment.FirstIndex, DrawSegment.NumIndices / 3, 1);
+										}
+									}
 								}
 							}
-							GlobalVertexOffset += CmdList->VtxBuffer.Size;
-							GlobalIndexOffset += CmdList->IdxBuffer.Size;
 						}
 					}
 				});
@@ -375,18 +564,29 @@ namespace ImGuiUtils
 			// slate resource can update when resizing atlases, keep track of what the gamethread thinks the resource is
 			// if it changes, we override the texture coordinates (not 100% correct, but works for most cases)
 			FSlateShaderResource* ExpectedSlateResource = nullptr;
+			bool IsSdfFont = false;
 		};
 		struct FBoundTexture
 		{
 			FTextureRHIRef TextureRHI = nullptr;
 			FSamplerStateRHIRef SamplerRHI = nullptr;
 			bool IsSRGB = false;
+			bool IsSdfFont = false;
 			FUintVector2 TexCoordOverrideMode = FUintVector2::ZeroValue;
 		};
 		TArray<FBoundTexture> m_BoundTextures;
 		TArray<FTextureResourceInfo> m_BoundTextureResources;
+		// game thread only
+		FImGuiOcclusionCulling m_OcclusionCulling;
+		// render thread only
+		FImGuiGlyphInstances m_GlyphInstances;
+		bool m_bInstanceGlyphs = true;
+		int32 m_GlyphInstancingMinRunLength = 8;
 		FVector2f m_DrawRectOffset = FVector2f::ZeroVector;
 		ImDrawDataSnapshot m_DrawDataSnapshot;
+		// debug names for gpu event scopes
+		FString m_ContextName;
+		TArray<FString> m_DrawListNames;
 		bool m_bHasDrawCommands = false;
 		bool m_bCaptureGpuFrame = false;
 	};
@@ -396,6 +596,8 @@ namespace ImGuiUtils
 	public:
 		bool SetDrawData(ImDrawData* DrawData, double CurrentTime, FVector2f DrawRectOffset)
 		{
+			DrawListTrimmer.Trim(DrawData, nullptr);
+
 			m_DrawData = DrawData;
 			m_DrawRectOffset = DrawRectOffset;
 
@@ -431,8 +633,12 @@ namespace ImGuiUtils
 
 			const FSlateRenderTransform WidgetTransform(FVector2f(AllottedGeometry.GetAccumulatedRenderTransform().GetTranslation()) - FVector2f(m_DrawData->DisplayPos.x, m_DrawData->DisplayPos.y));
 
+			int32 MaxVertexCount = 0;
+			int32 MaxIndexCount = 0;
 			for (const ImDrawList* CmdList : m_DrawData->CmdLists)
 			{
+				MaxVertexCount = FMath::Max(MaxVertexCount, CmdList->VtxBuffer.Size);
+
 				SlateVertices.SetNum(CmdList->VtxBuffer.Size, EAllowShrinking::No);
 				for (int32 VertexIndex = 0; VertexIndex < CmdList->VtxBuffer.Size; ++VertexIndex)
 				{
@@ -459,6 +665,7 @@ namespace ImGuiUtils
 						continue;
 					}
 
+					MaxIndexCount = FMath::Max(MaxIndexCount, (int32)DrawCmd.ElemCount);
 					SlateIndices.SetNum(DrawCmd.ElemCount, EAllowShrinking::No);
 					for (uint32 Index = 0; Index < DrawCmd.ElemCount; ++Index)
 					{
@@ -486,11 +693,43 @@ namespace ImGuiUtils
 					OutDrawElements.PopClip();
 				}
 			}
+
+			TrimSlateBuffers(MaxVertexCount, MaxIndexCount);
+		}
+
+	private:
+		void TrimSlateBuffers(int32 VertexCount, int32 IndexCount)
+		{
+			const FDrawBufferTrimPolicy Policy = FDrawBufferTrimPolicy::Get();
+			if (!Policy.IsEnabled())
+			{
+				return;
+			}
+
+			m_SlateVerticesTrimState.Update(VertexCount, SlateVertices.Max(), Policy);
+			m_SlateIndicesTrimState.Update(IndexCount, SlateIndices.Max(), Policy);
+
+			SIZE_T ReclaimedBytes = 0;
+			if (m_SlateVerticesTrimState.ShouldTrim(SlateVertices.Max(), sizeof(FSlateVertex), Policy))
+			{
+				ReclaimedBytes += TrimBuffer(SlateVertices, m_SlateVerticesTrimState.TrimCapacity);
+			}
+			if (m_SlateIndicesTrimState.ShouldTrim(SlateIndices.Max(), sizeof(SlateIndex), Policy))
+			{
+				ReclaimedBytes += TrimBuffer(SlateIndices, m_SlateIndicesTrimState.TrimCapacity);
+			}
+
+			if (ReclaimedBytes > 0)
+			{
+				INC_MEMORY_STAT_BY(STAT_ImGui_ReclaimedDrawMemory, ReclaimedBytes);
+			}
 		}
 
 	private:
 		TArray<FSlateVertex> SlateVertices;
 		TArray<SlateIndex> SlateIndices;
+		FDrawBufferTrimState m_SlateVerticesTrimState;
+		FDrawBufferTrimState m_SlateIndicesTrimState;
 		FVector2f m_DrawRectOffset = FVector2f::ZeroVector;
 		const ImDrawData* m_DrawData = nullptr;
 		bool m_bHasDrawCommands = false;
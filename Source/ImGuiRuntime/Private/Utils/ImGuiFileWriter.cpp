@@ -0,0 +1,77 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#include "ImGuiFileWriter.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/WindowsHWrapper.h"
+#elif PLATFORM_UNIX || PLATFORM_MAC
+#include <stdio.h>
+#endif
+
+static TAutoConsoleVariable<float> CVarFileWriteDelay(
+	TEXT("imgui.Persistence.WriteDelay"),
+	1.f,
+	TEXT("Seconds to wait before writing ImGui ini/save data files, repeated saves within this window are coalesced into a single write."));
+
+namespace ImGuiUtils
+{
+	void FImGuiFileWriter::Tick()
+	{
+		if (!WriteTask.IsCompleted())
+		{
+			return;
+		}
+
+		FScopeLock Lock(&CriticalSection);
+
+		InFlightWrites.Reset();
+		if (PendingWrites.IsEmpty() || (FPlatformTime::Seconds() - FirstPendingWriteTime) < CVarFileWriteDelay.GetValueOnGameThread())
+		{
+			return;
+		}
+
+		InFlightWrites = MoveTemp(PendingWrites);
+		PendingWrites.Reset();
+
+		WriteTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[this]()
+			{
+				// NOTE: in flight writes are only modified by the game thread once the task is complete
+				for (const TPair<FString, TArray<uint8>>& Write : InFlightWrites)
+				{
+					WriteFile(Write.Key, Write.Value);
+				}
+			}, LowLevelTasks::ETaskPriority::BackgroundNormal);
+	}
+
+	void FImGuiFileWriter::WriteFile(const FString& FilePath, const TArray<uint8>& Contents)
+	{
+		const FString TempFilePath = FilePath + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(Contents, *TempFilePath))
+		{
+			return;
+		}
+
+		// NOTE: IFileManager::Move deletes the destination before renaming, only used when the platform can't replace in place (read only files etc..)
+		if (!RenameOverFile(FilePath, TempFilePath) && !IFileManager::Get().Move(*FilePath, *TempFilePath, /*bReplace=*/true, /*bEvenIfReadOnly=*/true))
+		{
+			IFileManager::Get().Delete(*TempFilePath);
+		}
+	}
+
+	bool FImGuiFileWriter::RenameOverFile(const FString& FilePath, const FString& TempFilePath)
+	{
+		const FString AbsoluteFilePath = IFileManager::Get().ConvertToAbsolutePathForExternalAppForWrite(*FilePath);
+		const FString AbsoluteTempFilePath = IFileManager::Get().ConvertToAbsolutePathForExternalAppForWrite(*TempFilePath);
+#if PLATFORM_WINDOWS
+		return ::MoveFileExW(*AbsoluteTempFilePath, *AbsoluteFilePath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#elif PLATFORM_UNIX || PLATFORM_MAC
+		return ::rename(TCHAR_TO_UTF8(*AbsoluteTempFilePath), TCHAR_TO_UTF8(*AbsoluteFilePath)) == 0;
+#else
+		return false;
+#endif
+	}
+}
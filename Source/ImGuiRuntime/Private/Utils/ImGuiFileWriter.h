@@ -0,0 +1,82 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/ScopeLock.h"
+#include "Tasks/Task.h"
+
+namespace ImGuiUtils
+{
+	// writes files on a background task, contents are serialized on the game thread and only the latest contents per file are written
+	class FImGuiFileWriter : FNoncopyable
+	{
+	public:
+		~FImGuiFileWriter()
+		{
+			Flush();
+		}
+
+		// NOTE: game thread only
+		void QueueWrite(const FString& FilePath, TArray<uint8>&& Contents)
+		{
+			FScopeLock Lock(&CriticalSection);
+
+			if (PendingWrites.IsEmpty())
+			{
+				FirstPendingWriteTime = FPlatformTime::Seconds();
+			}
+			// replaces contents queued since the last write
+			PendingWrites.Add(FilePath, MoveTemp(Contents));
+		}
+
+		// contents that haven't reached the disk yet, so files can be read back right after saving
+		bool GetPendingContents(const FString& FilePath, TArray<uint8>& OutContents) const
+		{
+			FScopeLock Lock(&CriticalSection);
+
+			const TArray<uint8>* Contents = PendingWrites.Find(FilePath);
+			if (!Contents)
+			{
+				Contents = InFlightWrites.Find(FilePath);
+			}
+
+			if (Contents)
+			{
+				OutContents = *Contents;
+				return true;
+			}
+			return false;
+		}
+
+		// starts a write task once the oldest pending write is older than `imgui.Persistence.WriteDelay`
+		void Tick();
+
+		// waits for the write task and writes remaining files on the calling thread
+		void Flush()
+		{
+			WriteTask.Wait();
+
+			FScopeLock Lock(&CriticalSection);
+
+			InFlightWrites.Reset();
+			for (const TPair<FString, TArray<uint8>>& Write : PendingWrites)
+			{
+				WriteFile(Write.Key, Write.Value);
+			}
+			PendingWrites.Reset();
+		}
+
+	private:
+		// write to a temp file and swap it in, so a crash/power loss mid write doesn't leave a truncated file behind
+		static void WriteFile(const FString& FilePath, const TArray<uint8>& Contents);
+
+		// renames the temp file over the destination in a single step, readers see either the old or the new contents
+		static bool RenameOverFile(const FString& FilePath, const FString& TempFilePath);
+
+		mutable FCriticalSection CriticalSection;
+		TMap<FString, TArray<uint8>> PendingWrites;
+		TMap<FString, TArray<uint8>> InFlightWrites;
+		double FirstPendingWriteTime = 0.0;
+		UE::Tasks::FTask WriteTask;
+	};
+}
@@ -0,0 +1,103 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/FileHelper.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+
+DECLARE_MEMORY_STAT(TEXT("Font Data (Mapped)"), STAT_ImGui_FontDataMapped, STATGROUP_ImGui);
+DECLARE_MEMORY_STAT(TEXT("Font Data (Heap)"), STAT_ImGui_FontDataHeap, STATGROUP_ImGui);
+
+namespace ImGuiUtils
+{
+	// font file contents referenced by the shared font atlas (added with FontDataOwnedByAtlas = false)
+	// memory mapped when the platform supports it, so processes using the same font share the pages instead of each keeping a heap copy
+	class FImGuiFontData : FNoncopyable
+	{
+	public:
+		// NOTE: safe to call from any thread
+		static TUniquePtr<FImGuiFontData> Load(const FString& FilePath, bool bPrefetch = false)
+		{
+			TUniquePtr<FImGuiFontData> FontData{ new FImGuiFontData(FilePath) };
+			if (!FontData->Map(bPrefetch))
+			{
+				// files inside pak files (or platforms without mapped file support) end up here
+				if (!FFileHelper::LoadFileToArray(FontData->HeapData, *FilePath, FILEREAD_Silent) || FontData->HeapData.IsEmpty())
+				{
+					return nullptr;
+				}
+				INC_MEMORY_STAT_BY(STAT_ImGui_FontDataHeap, FontData->HeapData.Num());
+			}
+			return FontData;
+		}
+
+		~FImGuiFontData()
+		{
+			if (MappedRegion)
+			{
+				DEC_MEMORY_STAT_BY(STAT_ImGui_FontDataMapped, MappedRegion->GetMappedSize());
+			}
+			else
+			{
+				DEC_MEMORY_STAT_BY(STAT_ImGui_FontDataHeap, HeapData.Num());
+			}
+
+			// region has to go before the file handle
+			MappedRegion.Reset();
+			MappedHandle.Reset();
+		}
+
+		// NOTE: read only, ImGui doesn't write to the font data but the pages of a mapped file are not writable
+		void* GetData() const { return MappedRegion ? (void*)MappedRegion->GetMappedPtr() : (void*)HeapData.GetData(); }
+		int32 GetSize() const { return MappedRegion ? (int32)MappedRegion->GetMappedSize() : HeapData.Num(); }
+		bool IsMapped() const { return MappedRegion.IsValid(); }
+		const FString& GetFilePath() const { return FilePath; }
+
+	private:
+		explicit FImGuiFontData(const FString& InFilePath)
+			: FilePath(InFilePath)
+		{}
+
+		bool Map(bool bPrefetch)
+		{
+			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+#if ((ENGINE_MAJOR_VERSION * 100u + ENGINE_MINOR_VERSION) > 503) //(Version > 5.3)
+			FOpenMappedResult OpenResult = PlatformFile.OpenMappedEx(*FilePath);
+			if (OpenResult.HasValue())
+			{
+				MappedHandle = OpenResult.StealValue();
+			}
+#else
+			MappedHandle.Reset(PlatformFile.OpenMapped(*FilePath));
+#endif
+			// ImGui takes the font data size as int
+			if (!MappedHandle || MappedHandle->GetFileSize() <= 0 || MappedHandle->GetFileSize() > MAX_int32)
+			{
+				MappedHandle.Reset();
+				return false;
+			}
+
+			MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+			if (!MappedRegion)
+			{
+				MappedHandle.Reset();
+				return false;
+			}
+
+			if (bPrefetch)
+			{
+				// ask the OS to page in the file ahead of the atlas build
+				MappedRegion->PreloadHint();
+			}
+
+			INC_MEMORY_STAT_BY(STAT_ImGui_FontDataMapped, MappedRegion->GetMappedSize());
+			return true;
+		}
+
+		FString FilePath;
+		TUniquePtr<IMappedFileHandle> MappedHandle;
+		TUniquePtr<IMappedFileRegion> MappedRegion;
+		TArray<uint8> HeapData;
+	};
+}
@@ -0,0 +1,549 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/ScopeExit.h"
+#include "Tasks/Task.h"
+#include "ImGuiGlyphCache.h"
+#include "ImGuiStbTrueType.h"
+
+static TAutoConsoleVariable<int32> CVarMaxGlyphBakesPerFrame(
+	TEXT("imgui.Fonts.MaxGlyphBakesPerFrame"),
+	16,
+	TEXT("Number of glyphs widgets can rasterize per frame, remaining glyphs draw using the closest baked font size until they are baked at the start of the next frames (0 disables the limit)."));
+
+static TAutoConsoleVariable<float> CVarDeferredGlyphBakeBudgetMs(
+	TEXT("imgui.Fonts.DeferredGlyphBakeBudgetMs"),
+	1.f,
+	TEXT("Time (in ms) spent baking deferred glyphs at the start of each frame."));
+
+static TAutoConsoleVariable<bool> CVarAsyncGlyphBaking(
+	TEXT("imgui.Fonts.AsyncGlyphBaking"),
+	true,
+	TEXT("Rasterize glyphs over the per frame cap on worker threads, they are packed into the atlas at the start of the next frames.\n")
+	TEXT("Only used when the atlas is built with stb_truetype, FreeType atlases bake deferred glyphs on the game thread."));
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Glyph Bakes"), STAT_ImGui_GlyphBakes, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Deferred Glyph Bakes"), STAT_ImGui_DeferredGlyphBakes, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Glyph Bakes"), STAT_ImGui_AsyncGlyphBakes, STATGROUP_ImGui);
+
+namespace ImGuiUtils
+{
+	// wraps the font loader of the shared atlas, caps the number of glyphs rasterized while widgets tick
+	// glyphs over the cap get a pending glyph (borrowed from the closest baked size, or blank with the right advance), are rasterized
+	// into staging memory on a worker (`imgui.Fonts.AsyncGlyphBaking`, stb_truetype atlases only) and packed into the atlas at the start of a later frame
+	// NOTE: game thread only apart from the rasterization tasks, ImGui font loaders pack and rasterize in a single call and FreeType faces aren't thread safe
+	class FImGuiGlyphBaker : FNoncopyable
+	{
+	public:
+		FImGuiGlyphBaker(ImFontAtlas* InFontAtlas, const ImFontLoader* InFontLoader)
+			: FontAtlas(InFontAtlas)
+			, InnerFontLoader(InFontLoader)
+		{
+			check(Instance == nullptr);
+			Instance = this;
+
+			// same loader, only glyph loading (and source destruction, to wait for background bakes) goes through the baker
+			FontLoader = *InFontLoader;
+			FontLoader.FontBakedLoadGlyph = &FImGuiGlyphBaker::FontBakedLoadGlyph;
+			FontLoader.FontSrcDestroy = &FImGuiGlyphBaker::FontSrcDestroy;
+
+			// background bakes rasterize with stb_truetype, mixing them with glyphs (and advances) of another rasterizer would shift the layout once committed
+			bIsStbTrueTypeLoader = InFontLoader->Name && FCStringAnsi::Strcmp(InFontLoader->Name, "stb_truetype") == 0;
+		}
+
+		~FImGuiGlyphBaker()
+		{
+			for (TPair<uint64, FDeferredGlyph>& DeferredGlyph : DeferredGlyphs)
+			{
+				DeferredGlyph.Value.StagingTask.Wait();
+			}
+			WaitForDetachedTasks();
+			Instance = nullptr;
+		}
+
+		const ImFontLoader* GetFontLoader() const { return &FontLoader; }
+
+		// glyphs found in the cache are restored without rasterizing (and don't count against the bake budget)
+		void SetGlyphCache(FImGuiGlyphCache* InGlyphCache) { GlyphCache = InGlyphCache; }
+
+		// NOTE: call after the atlas frame update, before widgets start their frame
+		void BakeDeferredGlyphs()
+		{
+			if (DeferredGlyphs.IsEmpty())
+			{
+				return;
+			}
+
+			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Bake Deferred Glyphs"), STAT_ImGui_BakeDeferredGlyphs, STATGROUP_ImGui);
+
+			bIsBakingDeferredGlyphs = true;
+			ON_SCOPE_EXIT{ bIsBakingDeferredGlyphs = false; };
+
+			const double EndTime = FPlatformTime::Seconds() + CVarDeferredGlyphBakeBudgetMs.GetValueOnGameThread() / 1000.0;
+			for (auto It = DeferredGlyphs.CreateIterator(); It; ++It)
+			{
+				// background bakes are picked up once their pixels are staged
+				if (!It.Value().StagingTask.IsCompleted())
+				{
+					continue;
+				}
+
+				FDeferredGlyph DeferredGlyph = MoveTemp(It.Value());
+				It.RemoveCurrent();
+
+				// bakes can be discarded/compacted in between frames, only ids are stable
+				if (ImFontBaked* Baked = FindBaked(DeferredGlyph.BakedId))
+				{
+					// the loader packs the staged pixels instead of rasterizing (see LoadGlyph)
+					CommittingGlyph = DeferredGlyph.StagingTask.IsValid() ? &DeferredGlyph : nullptr;
+					ON_SCOPE_EXIT{ CommittingGlyph = nullptr; };
+
+					ReloadGlyph(Baked, DeferredGlyph.Codepoint);
+				}
+
+				if (FPlatformTime::Seconds() > EndTime)
+				{
+					break;
+				}
+			}
+
+			RefreshBorrowedGlyphs();
+		}
+
+	private:
+		// font source parsed for the background bakes, read only once created
+		struct FStagingFontSource
+		{
+			stbtt_fontinfo FontInfo;
+			// same as the stb_truetype loader (see ImGui_ImplStbTrueType_FontSrcInit)
+			float ScaleFactor = 0.f;
+		};
+
+		// glyph rasterized on a worker, metrics are final (relative to the pen position) and pixels are Alpha8
+		struct FStagedGlyph
+		{
+			float AdvanceX = 0.f;
+			float X0 = 0.f, Y0 = 0.f, X1 = 0.f, Y1 = 0.f;
+			int32 Width = 0;
+			int32 Height = 0;
+			TArray<uint8> Pixels;
+		};
+
+		struct FDeferredGlyph
+		{
+			ImGuiID BakedId = 0;
+			ImWchar Codepoint = 0;
+			// baked size the glyph was borrowed from, 0 when drawing the blank pending glyph
+			ImGuiID BorrowedBakedId = 0;
+			// source the glyph is baked from, the other sources of a merged font don't have it
+			const ImFontConfig* Src = nullptr;
+			// invalid (and completed) when the glyph is baked on the game thread
+			UE::Tasks::TTask<FStagedGlyph> StagingTask;
+		};
+
+		static bool FontBakedLoadGlyph(ImFontAtlas* Atlas, ImFontConfig* Src, ImFontBaked* Baked, void* LoaderData, ImWchar Codepoint, ImFontGlyph* OutGlyph, float* OutAdvanceX)
+		{
+			return Instance->LoadGlyph(Atlas, Src, Baked, LoaderData, Codepoint, OutGlyph, OutAdvanceX);
+		}
+
+		static void FontSrcDestroy(ImFontAtlas* Atlas, ImFontConfig* Src)
+		{
+			Instance->OnFontSrcDestroyed(Src);
+			if (Instance->InnerFontLoader->FontSrcDestroy)
+			{
+				Instance->InnerFontLoader->FontSrcDestroy(Atlas, Src);
+			}
+		}
+
+		bool LoadGlyph(ImFontAtlas* Atlas, ImFontConfig* Src, ImFontBaked* Baked, void* LoaderData, ImWchar Codepoint, ImFontGlyph* OutGlyph, float* OutAdvanceX)
+		{
+			if (CommittingGlyph && OutGlyph && CommittingGlyph->Src == Src)
+			{
+				const bool bCommitted = CommitStagedGlyph(Atlas, Src, Baked, Codepoint, CommittingGlyph->StagingTask.GetResult(), OutGlyph);
+				if (bCommitted && GlyphCache)
+				{
+					GlyphCache->Store(Atlas, Src, Baked, Codepoint, OutGlyph);
+				}
+				return bCommitted;
+			}
+
+			bool bLoaded = GlyphCache && GlyphCache->Restore(Atlas, Src, Baked, Codepoint, OutGlyph, OutAdvanceX);
+			if (!bLoaded && CanDeferGlyph(Atlas, Src, Baked, Codepoint, OutGlyph) && !TryConsumeBakeBudget())
+			{
+				// ImGui keeps whatever glyph this source returns, returning false would let the next merged source bake it
+				// and leak that atlas rect once the real glyph is baked, so the source always provides a pending glyph
+				ImFontGlyph PendingGlyph;
+				const ImGuiID BorrowedBakedId = BorrowGlyph(Atlas, Src, Baked, Codepoint, PendingGlyph);
+				if (BorrowedBakedId != 0 || MakeBlankGlyph(Atlas, Src, Baked, LoaderData, Codepoint, PendingGlyph))
+				{
+					INC_DWORD_STAT(STAT_ImGui_DeferredGlyphBakes);
+
+					FDeferredGlyph& DeferredGlyph = DeferredGlyphs.FindOrAdd(GetGlyphKey(Baked->BakedId, Codepoint));
+					DeferredGlyph.BakedId = Baked->BakedId;
+					DeferredGlyph.Codepoint = Codepoint;
+					DeferredGlyph.BorrowedBakedId = BorrowedBakedId;
+					DeferredGlyph.Src = Src;
+					DeferredGlyph.StagingTask = LaunchStagingTask(Src, Baked, Codepoint);
+
+					*OutGlyph = PendingGlyph;
+					return true;
+				}
+			}
+
+			if (!bLoaded)
+			{
+				INC_DWORD_STAT(STAT_ImGui_GlyphBakes);
+				bLoaded = InnerFontLoader->FontBakedLoadGlyph(Atlas, Src, Baked, LoaderData, Codepoint, OutGlyph, OutAdvanceX);
+				if (bLoaded && OutGlyph && GlyphCache)
+				{
+					GlyphCache->Store(Atlas, Src, Baked, Codepoint, OutGlyph);
+				}
+			}
+
+			// texture grew or got repacked, borrowed glyphs point to stale uvs
+			if (!bIsBakingDeferredGlyphs && GetTextureID() != LastTextureID)
+			{
+				RefreshBorrowedGlyphs();
+			}
+			return bLoaded;
+		}
+
+		// glyph without pixels but with the advance of the real one (metrics only load), so the layout doesn't change once it is baked
+		bool MakeBlankGlyph(ImFontAtlas* Atlas, ImFontConfig* Src, ImFontBaked* Baked, void* LoaderData, ImWchar Codepoint, ImFontGlyph& OutGlyph) const
+		{
+			float AdvanceX = 0.f;
+			if (!InnerFontLoader->FontBakedLoadGlyph(Atlas, Src, Baked, LoaderData, Codepoint, nullptr, &AdvanceX))
+			{
+				return false;
+			}
+
+			OutGlyph.Codepoint = Codepoint;
+			OutGlyph.AdvanceX = AdvanceX;
+			OutGlyph.Visible = false;
+			OutGlyph.PackId = ImFontAtlasRectId_Invalid;
+			return true;
+		}
+
+		// starts rasterizing the glyph into staging memory, returns an invalid task when it has to be baked on the game thread
+		UE::Tasks::TTask<FStagedGlyph> LaunchStagingTask(ImFontConfig* Src, ImFontBaked* Baked, ImWchar Codepoint)
+		{
+			// the game thread bake goes through the atlas loader, same rasterizer as the pending glyph metrics
+			if (!bIsStbTrueTypeLoader || !CVarAsyncGlyphBaking.GetValueOnGameThread())
+			{
+				return {};
+			}
+
+			const FStagingFontSource* FontSource = GetStagingFontSource(Src);
+			const int32 GlyphIndex = FontSource ? stbtt_FindGlyphIndex(&FontSource->FontInfo, Codepoint) : 0;
+			if (GlyphIndex == 0)
+			{
+				return {};
+			}
+
+			// everything that depends on the atlas is resolved here, the task only reads the font data
+			int32 OversampleH = 1, OversampleV = 1;
+			ImFontAtlasBuildGetOversampleFactors(Src, Baked, &OversampleH, &OversampleV);
+			const float RasterizerDensity = Src->RasterizerDensity * Baked->RasterizerDensity;
+			const float ScaleForLayout = FontSource->ScaleFactor * Baked->Size;
+			const float ScaleForRasterX = ScaleForLayout * RasterizerDensity * OversampleH;
+			const float ScaleForRasterY = ScaleForLayout * RasterizerDensity * OversampleV;
+
+			const float RefSize = Baked->OwnerFont->Sources[0]->SizePixels;
+			const float OffsetsScale = (RefSize != 0.f) ? (Baked->Size / RefSize) : 1.f;
+			const float FontOffsetX = ImFloor(Src->GlyphOffset.x * OffsetsScale + 0.5f);
+			const float FontOffsetY = ImFloor(Src->GlyphOffset.y * OffsetsScale + 0.5f) + IM_ROUND(Baked->Ascent);
+
+			INC_DWORD_STAT(STAT_ImGui_AsyncGlyphBakes);
+			return UE::Tasks::Launch(UE_SOURCE_LOCATION,
+				[FontSource, GlyphIndex, OversampleH, OversampleV, RasterizerDensity, ScaleForLayout, ScaleForRasterX, ScaleForRasterY, FontOffsetX, FontOffsetY]()
+				{
+					FStagedGlyph StagedGlyph;
+
+					// same as ImGui_ImplStbTrueType_FontBakedLoadGlyph, minus packing
+					int32 Advance = 0, LeftSideBearing = 0;
+					stbtt_GetGlyphHMetrics(&FontSource->FontInfo, GlyphIndex, &Advance, &LeftSideBearing);
+					StagedGlyph.AdvanceX = Advance * ScaleForLayout;
+
+					int32 X0 = 0, Y0 = 0, X1 = 0, Y1 = 0;
+					stbtt_GetGlyphBitmapBoxSubpixel(&FontSource->FontInfo, GlyphIndex, ScaleForRasterX, ScaleForRasterY, 0.f, 0.f, &X0, &Y0, &X1, &Y1);
+					if (X0 == X1 || Y0 == Y1)
+					{
+						return StagedGlyph;
+					}
+
+					StagedGlyph.Width = X1 - X0 + OversampleH - 1;
+					StagedGlyph.Height = Y1 - Y0 + OversampleV - 1;
+					StagedGlyph.Pixels.SetNumZeroed(StagedGlyph.Width * StagedGlyph.Height);
+
+					float SubX = 0.f, SubY = 0.f;
+					stbtt_GetGlyphBitmapBox(&FontSource->FontInfo, GlyphIndex, ScaleForRasterX, ScaleForRasterY, &X0, &Y0, &X1, &Y1);
+					stbtt_MakeGlyphBitmapSubpixelPrefilter(&FontSource->FontInfo, StagedGlyph.Pixels.GetData(), StagedGlyph.Width, StagedGlyph.Height, StagedGlyph.Width,
+						ScaleForRasterX, ScaleForRasterY, 0.f, 0.f, OversampleH, OversampleV, &SubX, &SubY, GlyphIndex);
+
+					const float RecipH = 1.f / (OversampleH * RasterizerDensity);
+					const float RecipV = 1.f / (OversampleV * RasterizerDensity);
+					StagedGlyph.X0 = X0 * RecipH + FontOffsetX + SubX;
+					StagedGlyph.Y0 = Y0 * RecipV + FontOffsetY + SubY;
+					StagedGlyph.X1 = (X0 + StagedGlyph.Width) * RecipH + FontOffsetX + SubX;
+					StagedGlyph.Y1 = (Y0 + StagedGlyph.Height) * RecipV + FontOffsetY + SubY;
+					return StagedGlyph;
+				}, LowLevelTasks::ETaskPriority::BackgroundHigh);
+		}
+
+		// packs the staged pixels into the atlas, ImGui then adds the glyph (uvs, advance clamping etc..) like any loaded glyph
+		static bool CommitStagedGlyph(ImFontAtlas* Atlas, ImFontConfig* Src, ImFontBaked* Baked, ImWchar Codepoint, const FStagedGlyph& StagedGlyph, ImFontGlyph* OutGlyph)
+		{
+			OutGlyph->Codepoint = Codepoint;
+			OutGlyph->AdvanceX = StagedGlyph.AdvanceX;
+			if (StagedGlyph.Pixels.IsEmpty())
+			{
+				return true;
+			}
+
+			const ImFontAtlasRectId PackId = ImFontAtlasPackAddRect(Atlas, StagedGlyph.Width, StagedGlyph.Height);
+			if (PackId == ImFontAtlasRectId_Invalid)
+			{
+				return false;
+			}
+			ImTextureRect* Rect = ImFontAtlasPackGetRect(Atlas, PackId);
+
+			OutGlyph->X0 = StagedGlyph.X0;
+			OutGlyph->Y0 = StagedGlyph.Y0;
+			OutGlyph->X1 = StagedGlyph.X1;
+			OutGlyph->Y1 = StagedGlyph.Y1;
+			OutGlyph->Visible = true;
+			OutGlyph->PackId = PackId;
+			ImFontAtlasBakedSetFontGlyphBitmap(Atlas, Baked, Src, OutGlyph, Rect, StagedGlyph.Pixels.GetData(), ImTextureFormat_Alpha8, StagedGlyph.Width);
+			return true;
+		}
+
+		// nullptr when stb_truetype can't parse the font data
+		const FStagingFontSource* GetStagingFontSource(const ImFontConfig* Src)
+		{
+			if (const TUniquePtr<FStagingFontSource>* FontSource = StagingFontSources.Find(Src))
+			{
+				return FontSource->Get();
+			}
+
+			TUniquePtr<FStagingFontSource> FontSource = MakeUnique<FStagingFontSource>();
+			const int32 FontOffset = stbtt_GetFontOffsetForIndex((const unsigned char*)Src->FontData, Src->FontNo);
+			if (FontOffset < 0 || !stbtt_InitFont(&FontSource->FontInfo, (const unsigned char*)Src->FontData, FontOffset))
+			{
+				FontSource.Reset();
+			}
+			else
+			{
+				const float RefSize = Src->DstFont->Sources[0]->SizePixels;
+				FontSource->ScaleFactor = stbtt_ScaleForPixelHeight(&FontSource->FontInfo, 1.f) * Src->ExtraSizeScale;
+				if (Src->MergeMode && Src->SizePixels != 0.f && RefSize != 0.f)
+				{
+					FontSource->ScaleFactor *= Src->SizePixels / RefSize;
+				}
+			}
+			return StagingFontSources.Add(Src, MoveTemp(FontSource)).Get();
+		}
+
+		// tasks read the font data, which goes away with the source
+		void OnFontSrcDestroyed(const ImFontConfig* Src)
+		{
+			for (auto It = DeferredGlyphs.CreateIterator(); It; ++It)
+			{
+				if (It.Value().Src == Src)
+				{
+					It.Value().StagingTask.Wait();
+					It.RemoveCurrent();
+				}
+			}
+			WaitForDetachedTasks();
+			StagingFontSources.Remove(Src);
+		}
+
+		void DetachStagingTask(FDeferredGlyph& DeferredGlyph)
+		{
+			DetachedTasks.RemoveAllSwap([](const UE::Tasks::TTask<FStagedGlyph>& Task) { return Task.IsCompleted(); }, EAllowShrinking::No);
+			if (!DeferredGlyph.StagingTask.IsCompleted())
+			{
+				DetachedTasks.Add(DeferredGlyph.StagingTask);
+			}
+		}
+
+		void WaitForDetachedTasks()
+		{
+			UE::Tasks::Wait(DetachedTasks);
+			DetachedTasks.Reset();
+		}
+
+		bool CanDeferGlyph(ImFontAtlas* Atlas, ImFontConfig* Src, ImFontBaked* Baked, ImWchar Codepoint, ImFontGlyph* OutGlyph) const
+		{
+			const ImFont* Font = Baked->OwnerFont;
+
+			// metrics only requests are cheap, fallback glyphs are needed right away
+			if (!OutGlyph || bIsBakingDeferredGlyphs || Baked->LoadNoFallback || Codepoint == Font->FallbackChar || Codepoint == Font->EllipsisChar)
+			{
+				return false;
+			}
+			// lookup tables use the codepoint before remapping, which the loader doesn't know about
+			if (Font->RemapPairs.Data.Size != 0)
+			{
+				return false;
+			}
+			// let sources that don't have the glyph fail right away, so merged fonts only defer once
+			return !InnerFontLoader->FontSrcContainsGlyph || InnerFontLoader->FontSrcContainsGlyph(Atlas, Src, Codepoint);
+		}
+
+		bool TryConsumeBakeBudget()
+		{
+			const int32 MaxBakesPerFrame = CVarMaxGlyphBakesPerFrame.GetValueOnGameThread();
+			if (MaxBakesPerFrame <= 0)
+			{
+				return true;
+			}
+
+			if (BakeBudgetFrame != GFrameCounter)
+			{
+				BakeBudgetFrame = GFrameCounter;
+				NumBakesThisFrame = 0;
+			}
+			return NumBakesThisFrame++ < MaxBakesPerFrame;
+		}
+
+		// copies the glyph from the closest baked size (scaled), returns the id of that baked size or 0 if it doesn't have the glyph
+		static ImGuiID BorrowGlyph(ImFontAtlas* Atlas, ImFontConfig* Src, ImFontBaked* Baked, ImWchar Codepoint, ImFontGlyph& OutGlyph)
+		{
+			ImFontBaked* ClosestBaked = ImFontAtlasBakedGetClosestMatch(Atlas, Baked->OwnerFont, Baked->Size, Baked->RasterizerDensity);
+			const ImFontGlyph* ClosestGlyph = ClosestBaked ? FindLoadedGlyph(ClosestBaked, Codepoint) : nullptr;
+			// only borrow glyphs that own their pixels (or don't have any)
+			if (!ClosestGlyph || ClosestGlyph->SourceIdx != Baked->OwnerFont->Sources.find_index(Src) || (ClosestGlyph->Visible && ClosestGlyph->PackId == ImFontAtlasRectId_Invalid))
+			{
+				return 0;
+			}
+
+			const float Scale = Baked->Size / ClosestBaked->Size;
+			OutGlyph.Colored = ClosestGlyph->Colored;
+			OutGlyph.Visible = ClosestGlyph->Visible;
+			OutGlyph.AdvanceX = (ClosestGlyph->AdvanceX - Src->GlyphExtraAdvanceX) * Scale;
+			OutGlyph.X0 = ClosestGlyph->X0 * Scale;
+			OutGlyph.Y0 = ClosestGlyph->Y0 * Scale;
+			OutGlyph.X1 = ClosestGlyph->X1 * Scale;
+			OutGlyph.Y1 = ClosestGlyph->Y1 * Scale;
+			// NOTE: no pack id, the atlas doesn't update uvs of this glyph when the texture is repacked (see RefreshBorrowedGlyphs)
+			OutGlyph.U0 = ClosestGlyph->U0;
+			OutGlyph.V0 = ClosestGlyph->V0;
+			OutGlyph.U1 = ClosestGlyph->U1;
+			OutGlyph.V1 = ClosestGlyph->V1;
+			OutGlyph.PackId = ImFontAtlasRectId_Invalid;
+			return ClosestBaked->BakedId;
+		}
+
+		// re-copies uvs of borrowed glyphs, bakes them right away if the glyph they were borrowed from is gone
+		void RefreshBorrowedGlyphs()
+		{
+			bIsBakingDeferredGlyphs = true;
+			ON_SCOPE_EXIT{ bIsBakingDeferredGlyphs = false; };
+
+			// baking a glyph below can grow the texture again
+			while (LastTextureID != GetTextureID())
+			{
+				LastTextureID = GetTextureID();
+				RefreshBorrowedGlyphUVs();
+			}
+		}
+
+		void RefreshBorrowedGlyphUVs()
+		{
+			for (auto It = DeferredGlyphs.CreateIterator(); It; ++It)
+			{
+				FDeferredGlyph& DeferredGlyph = It.Value();
+				if (DeferredGlyph.BorrowedBakedId == 0)
+				{
+					continue;
+				}
+
+				ImFontBaked* Baked = FindBaked(DeferredGlyph.BakedId);
+				ImFontGlyph* Glyph = Baked ? FindLoadedGlyph(Baked, DeferredGlyph.Codepoint) : nullptr;
+				if (!Glyph)
+				{
+					DetachStagingTask(DeferredGlyph);
+					It.RemoveCurrent();
+					continue;
+				}
+
+				ImFontBaked* BorrowedBaked = FindBaked(DeferredGlyph.BorrowedBakedId);
+				const ImFontGlyph* BorrowedGlyph = BorrowedBaked ? FindLoadedGlyph(BorrowedBaked, DeferredGlyph.Codepoint) : nullptr;
+				if (BorrowedGlyph && BorrowedGlyph->PackId != ImFontAtlasRectId_Invalid)
+				{
+					Glyph->U0 = BorrowedGlyph->U0;
+					Glyph->V0 = BorrowedGlyph->V0;
+					Glyph->U1 = BorrowedGlyph->U1;
+					Glyph->V1 = BorrowedGlyph->V1;
+				}
+				else if (DeferredGlyph.StagingTask.IsValid())
+				{
+					// pixels we borrowed may belong to a different glyph now, draw it blank until the staged pixels are packed
+					Glyph->Visible = false;
+					DeferredGlyph.BorrowedBakedId = 0;
+				}
+				else if (BorrowedGlyph == nullptr || BorrowedGlyph->Visible)
+				{
+					// pixels we borrowed may belong to a different glyph now
+					ReloadGlyph(Baked, DeferredGlyph.Codepoint);
+					It.RemoveCurrent();
+				}
+			}
+		}
+
+		int32 GetTextureID() const
+		{
+			return FontAtlas->TexData ? FontAtlas->TexData->UniqueID : 0;
+		}
+
+		ImFontBaked* FindBaked(ImGuiID BakedId) const
+		{
+			ImFontBaked* Baked = FontAtlas->Builder ? (ImFontBaked*)FontAtlas->Builder->BakedMap.GetVoidPtr(BakedId) : nullptr;
+			return (Baked && !Baked->WantDestroy) ? Baked : nullptr;
+		}
+
+		// glyph that has already been loaded, never triggers a load
+		static ImFontGlyph* FindLoadedGlyph(ImFontBaked* Baked, ImWchar Codepoint)
+		{
+			return Baked->IsGlyphLoaded(Codepoint) ? Baked->FindGlyphNoFallback(Codepoint) : nullptr;
+		}
+
+		// discards the pending glyph and loads it again through the loader
+		// NOTE: the pending glyph stays in the glyph list (without pixels), it is just no longer referenced
+		void ReloadGlyph(ImFontBaked* Baked, ImWchar Codepoint) const
+		{
+			if (ImFontGlyph* PendingGlyph = FindLoadedGlyph(Baked, Codepoint))
+			{
+				ImFontAtlasBakedDiscardFontGlyph(FontAtlas, Baked->OwnerFont, Baked, PendingGlyph);
+			}
+			Baked->FindGlyph(Codepoint);
+		}
+
+		static uint64 GetGlyphKey(ImGuiID BakedId, ImWchar Codepoint)
+		{
+			return ((uint64)BakedId << 32) | (uint64)Codepoint;
+		}
+
+		// font loader callbacks don't carry user data
+		static inline FImGuiGlyphBaker* Instance = nullptr;
+
+		ImFontAtlas* FontAtlas = nullptr;
+		const ImFontLoader* InnerFontLoader = nullptr;
+		ImFontLoader FontLoader;
+		FImGuiGlyphCache* GlyphCache = nullptr;
+		bool bIsStbTrueTypeLoader = false;
+
+		TMap<uint64, FDeferredGlyph> DeferredGlyphs;
+		TMap<const ImFontConfig*, TUniquePtr<FStagingFontSource>> StagingFontSources;
+		// deferred glyph being packed by BakeDeferredGlyphs
+		FDeferredGlyph* CommittingGlyph = nullptr;
+		// tasks of deferred glyphs dropped while rasterizing, they still read the font data
+		TArray<UE::Tasks::TTask<FStagedGlyph>> DetachedTasks;
+		uint64 BakeBudgetFrame = 0;
+		int32 NumBakesThisFrame = 0;
+		int32 LastTextureID = 0;
+		bool bIsBakingDeferredGlyphs = false;
+	};
+}
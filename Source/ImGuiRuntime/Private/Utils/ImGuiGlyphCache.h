@@ -0,0 +1,348 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/FileHelper.h"
+#include "Hash/CityHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static TAutoConsoleVariable<bool> CVarEnableGlyphCache(
+	TEXT("imgui.Fonts.GlyphCache"),
+	true,
+	TEXT("Keep rasterized glyphs in a cache file (Saved/ImGui), so later sessions restore glyph pixels and metrics instead of rasterizing them."),
+	ECVF_ReadOnly);
+
+static TAutoConsoleVariable<int32> CVarGlyphCacheMaxSizeMB(
+	TEXT("imgui.Fonts.GlyphCacheMaxSizeMB"),
+	32,
+	TEXT("Size limit of the glyph cache file, glyphs used in the current session are kept first."));
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cached Glyph Restores"), STAT_ImGui_CachedGlyphRestores, STATGROUP_ImGui);
+DECLARE_MEMORY_STAT(TEXT("Glyph Cache"), STAT_ImGui_GlyphCacheMemory, STATGROUP_ImGui);
+
+namespace ImGuiUtils
+{
+	// rasterized glyphs (pixels in atlas texture format + metrics) keyed by font data hash, loader, font config and baked size
+	// NOTE: Load can run on any thread before the cache is used, everything else is game thread only
+	class FImGuiGlyphCache : FNoncopyable
+	{
+	public:
+		~FImGuiGlyphCache()
+		{
+			DEC_MEMORY_STAT_BY(STAT_ImGui_GlyphCacheMemory, MemoryUsage);
+		}
+
+		void Load(const FString& FilePath)
+		{
+			TArray<uint8> FileData;
+			if (!FFileHelper::LoadFileToArray(FileData, *FilePath, FILEREAD_Silent))
+			{
+				return;
+			}
+
+			FMemoryReader Reader(FileData);
+			uint32 Magic = 0, Version = 0, ImGuiVersion = 0;
+			int64 PayloadSize = 0;
+			Reader << Magic << Version << ImGuiVersion << PayloadSize;
+			// ImGui version is part of the header as loaders/post processing can change b/w versions
+			if (Reader.IsError() || Magic != FileMagic || Version != FileVersion || ImGuiVersion != IMGUI_VERSION_NUM)
+			{
+				return;
+			}
+			// truncated/partially written files
+			if (PayloadSize != Reader.TotalSize() - Reader.Tell())
+			{
+				return;
+			}
+
+			SerializeMap(Reader, Sources);
+			if (Reader.IsError())
+			{
+				Sources.Reset();
+				return;
+			}
+
+			for (const TPair<uint64, FCachedSource>& Source : Sources)
+			{
+				for (const TPair<uint32, FCachedGlyph>& Glyph : Source.Value.Glyphs)
+				{
+					MemoryUsage += Glyph.Value.Pixels.GetAllocatedSize();
+				}
+			}
+			INC_MEMORY_STAT_BY(STAT_ImGui_GlyphCacheMemory, MemoryUsage);
+		}
+
+		// glyphs used in this session first, then older ones until the size limit is reached
+		bool Save(TArray<uint8>& OutFileData)
+		{
+			if (!bIsDirty)
+			{
+				return false;
+			}
+			bIsDirty = false;
+
+			const int64 MaxSize = (int64)FMath::Max(CVarGlyphCacheMaxSizeMB.GetValueOnGameThread(), 0) * 1024 * 1024;
+
+			TMap<uint64, FCachedSource> SavedSources;
+			int64 SavedSize = 0;
+			bool bIsFull = false;
+			for (int32 Pass = 0; Pass < 2 && !bIsFull; ++Pass)
+			{
+				const bool bUsedThisSession = (Pass == 0);
+				for (const TPair<uint64, FCachedSource>& Source : Sources)
+				{
+					for (const TPair<uint32, FCachedGlyph>& Glyph : Source.Value.Glyphs)
+					{
+						if (Glyph.Value.bUsedThisSession != bUsedThisSession)
+						{
+							continue;
+						}
+
+						SavedSize += sizeof(FCachedGlyph) + Glyph.Value.Pixels.Num();
+						if (SavedSize > MaxSize)
+						{
+							// stop at the first glyph over the limit, older glyphs never replace ones used this session
+							bIsFull = true;
+							break;
+						}
+						SavedSources.FindOrAdd(Source.Key).Glyphs.Add(Glyph.Key, Glyph.Value);
+					}
+					if (bIsFull)
+					{
+						break;
+					}
+				}
+			}
+
+			FMemoryWriter Writer(OutFileData);
+			uint32 Magic = FileMagic, Version = FileVersion, ImGuiVersion = IMGUI_VERSION_NUM;
+			int64 PayloadSize = 0;
+			Writer << Magic << Version << ImGuiVersion;
+			const int64 PayloadSizeOffset = Writer.Tell();
+			Writer << PayloadSize;
+			SerializeMap(Writer, SavedSources);
+
+			PayloadSize = Writer.Tell() - PayloadSizeOffset - sizeof(PayloadSize);
+			Writer.Seek(PayloadSizeOffset);
+			Writer << PayloadSize;
+			return true;
+		}
+
+		// fills the glyph from the cache, adding its pixels to the atlas
+		bool Restore(ImFontAtlas* Atlas, ImFontConfig* Src, ImFontBaked* Baked, ImWchar Codepoint, ImFontGlyph* OutGlyph, float* OutAdvanceX)
+		{
+			FCachedSource* Source = Sources.Find(GetSourceKey(Atlas, Src, Baked));
+			FCachedGlyph* CachedGlyph = Source ? Source->Glyphs.Find(Codepoint) : nullptr;
+			if (!CachedGlyph)
+			{
+				return false;
+			}
+			// pixels have to match the rect, the file might come from a different build
+			if (CachedGlyph->bVisible && CachedGlyph->Pixels.Num() != CachedGlyph->Width * CachedGlyph->Height * Atlas->TexData->BytesPerPixel)
+			{
+				MemoryUsage -= CachedGlyph->Pixels.GetAllocatedSize();
+				DEC_MEMORY_STAT_BY(STAT_ImGui_GlyphCacheMemory, CachedGlyph->Pixels.GetAllocatedSize());
+				Source->Glyphs.Remove(Codepoint);
+				return false;
+			}
+			CachedGlyph->bUsedThisSession = true;
+
+			// metrics only
+			if (OutAdvanceX)
+			{
+				*OutAdvanceX = CachedGlyph->AdvanceX;
+				return true;
+			}
+
+			OutGlyph->Codepoint = Codepoint;
+			OutGlyph->AdvanceX = CachedGlyph->AdvanceX;
+			OutGlyph->Colored = CachedGlyph->bColored;
+			if (CachedGlyph->bVisible)
+			{
+				const ImFontAtlasRectId PackId = ImFontAtlasPackAddRect(Atlas, CachedGlyph->Width, CachedGlyph->Height);
+				if (PackId == ImFontAtlasRectId_Invalid)
+				{
+					return false;
+				}
+				const ImTextureRect* Rect = ImFontAtlasPackGetRect(Atlas, PackId);
+
+				// NOTE: packing can grow the texture, fetch it afterwards
+				ImTextureData* TexData = Atlas->TexData;
+				const int32 RowSize = CachedGlyph->Width * TexData->BytesPerPixel;
+				for (int32 Row = 0; Row < CachedGlyph->Height; ++Row)
+				{
+					FMemory::Memcpy(TexData->GetPixelsAt(Rect->x, Rect->y + Row), CachedGlyph->Pixels.GetData() + Row * RowSize, RowSize);
+				}
+				ImFontAtlasTextureBlockQueueUpload(Atlas, TexData, Rect->x, Rect->y, Rect->w, Rect->h);
+
+				OutGlyph->X0 = CachedGlyph->X0;
+				OutGlyph->Y0 = CachedGlyph->Y0;
+				OutGlyph->X1 = CachedGlyph->X1;
+				OutGlyph->Y1 = CachedGlyph->Y1;
+				OutGlyph->Visible = true;
+				OutGlyph->PackId = PackId;
+			}
+
+			INC_DWORD_STAT(STAT_ImGui_CachedGlyphRestores);
+			return true;
+		}
+
+		// call after the font loader rasterized a glyph, pixels are read back from the atlas texture
+		void Store(ImFontAtlas* Atlas, ImFontConfig* Src, ImFontBaked* Baked, ImWchar Codepoint, const ImFontGlyph* Glyph)
+		{
+			FCachedGlyph CachedGlyph;
+			CachedGlyph.AdvanceX = Glyph->AdvanceX;
+			CachedGlyph.bColored = Glyph->Colored;
+			CachedGlyph.bUsedThisSession = true;
+			if (Glyph->Visible && Glyph->PackId != ImFontAtlasRectId_Invalid)
+			{
+				const ImTextureRect* Rect = ImFontAtlasPackGetRect(Atlas, Glyph->PackId);
+				const ImTextureData* TexData = Atlas->TexData;
+				const int32 RowSize = Rect->w * TexData->BytesPerPixel;
+
+				CachedGlyph.Pixels.SetNumUninitialized(RowSize * Rect->h);
+				for (int32 Row = 0; Row < Rect->h; ++Row)
+				{
+					FMemory::Memcpy(CachedGlyph.Pixels.GetData() + Row * RowSize, TexData->GetPixelsAt(Rect->x, Rect->y + Row), RowSize);
+				}
+
+				CachedGlyph.X0 = Glyph->X0;
+				CachedGlyph.Y0 = Glyph->Y0;
+				CachedGlyph.X1 = Glyph->X1;
+				CachedGlyph.Y1 = Glyph->Y1;
+				CachedGlyph.Width = Rect->w;
+				CachedGlyph.Height = Rect->h;
+				CachedGlyph.bVisible = true;
+			}
+
+			MemoryUsage += CachedGlyph.Pixels.GetAllocatedSize();
+			INC_MEMORY_STAT_BY(STAT_ImGui_GlyphCacheMemory, CachedGlyph.Pixels.GetAllocatedSize());
+
+			Sources.FindOrAdd(GetSourceKey(Atlas, Src, Baked)).Glyphs.Add(Codepoint, MoveTemp(CachedGlyph));
+			bIsDirty = true;
+		}
+
+	private:
+		struct FCachedGlyph
+		{
+			float AdvanceX = 0.f;
+			float X0 = 0.f, Y0 = 0.f, X1 = 0.f, Y1 = 0.f;
+			uint16 Width = 0;
+			uint16 Height = 0;
+			bool bVisible = false;
+			bool bColored = false;
+			// pixels in atlas texture format, after post processing
+			TArray<uint8> Pixels;
+
+			// not serialized
+			bool bUsedThisSession = false;
+
+			friend FArchive& operator<<(FArchive& Ar, FCachedGlyph& Glyph)
+			{
+				Ar << Glyph.AdvanceX << Glyph.X0 << Glyph.Y0 << Glyph.X1 << Glyph.Y1;
+				Ar << Glyph.Width << Glyph.Height << Glyph.bVisible << Glyph.bColored;
+
+				int32 NumPixels = Glyph.Pixels.Num();
+				Ar << NumPixels;
+				// sizes are validated before allocating, a corrupted file could ask for anything
+				if (Ar.IsLoading())
+				{
+					if (Ar.IsError() || NumPixels < 0 || NumPixels > Ar.TotalSize() - Ar.Tell())
+					{
+						Ar.SetError();
+						return Ar;
+					}
+					Glyph.Pixels.SetNumUninitialized(NumPixels);
+				}
+				Ar.Serialize(Glyph.Pixels.GetData(), NumPixels);
+				return Ar;
+			}
+		};
+
+		struct FCachedSource
+		{
+			TMap<uint32, FCachedGlyph> Glyphs;
+
+			friend FArchive& operator<<(FArchive& Ar, FCachedSource& Source)
+			{
+				SerializeMap(Ar, Source.Glyphs);
+				return Ar;
+			}
+		};
+
+		// same layout as TMap serialization, element counts are checked against the remaining file size before reserving
+		template<typename KeyType, typename ValueType>
+		static void SerializeMap(FArchive& Ar, TMap<KeyType, ValueType>& Map)
+		{
+			int32 Num = Map.Num();
+			Ar << Num;
+
+			if (!Ar.IsLoading())
+			{
+				for (TPair<KeyType, ValueType>& Pair : Map)
+				{
+					Ar << Pair.Key << Pair.Value;
+				}
+				return;
+			}
+
+			Map.Reset();
+			if (Ar.IsError() || Num < 0 || Num > (Ar.TotalSize() - Ar.Tell()) / (int64)sizeof(KeyType))
+			{
+				Ar.SetError();
+				return;
+			}
+
+			Map.Reserve(Num);
+			for (int32 Index = 0; Index < Num && !Ar.IsError(); ++Index)
+			{
+				KeyType Key;
+				ValueType Value;
+				Ar << Key << Value;
+				Map.Add(Key, MoveTemp(Value));
+			}
+		}
+
+		// everything that changes the rasterized output of a glyph
+		uint64 GetSourceKey(ImFontAtlas* Atlas, ImFontConfig* Src, ImFontBaked* Baked)
+		{
+			uint64& FontDataHash = FontDataHashes.FindOrAdd(Src->FontData);
+			if (FontDataHash == 0)
+			{
+				FontDataHash = CityHash64((const char*)Src->FontData, Src->FontDataSize);
+			}
+
+			const ImFontConfig* RefSrc = Baked->OwnerFont->Sources[0];
+			uint64 Key = CityHash64WithSeed(Atlas->FontLoaderName, FCStringAnsi::Strlen(Atlas->FontLoaderName), FontDataHash);
+			const auto HashValue = [&Key](const auto& Value)
+				{
+					Key = CityHash64WithSeed((const char*)&Value, sizeof(Value), Key);
+				};
+			HashValue(Src->FontNo);
+			HashValue(Src->FontLoaderFlags);
+			HashValue(Atlas->FontLoaderFlags);
+			HashValue(Src->OversampleH);
+			HashValue(Src->OversampleV);
+			HashValue(Src->PixelSnapH);
+			HashValue(Src->GlyphOffset.x);
+			HashValue(Src->GlyphOffset.y);
+			HashValue(Src->RasterizerMultiply);
+			HashValue(Src->RasterizerDensity);
+			HashValue(Src->ExtraSizeScale);
+			HashValue(RefSrc->SizePixels);
+			HashValue(Baked->Size);
+			HashValue(Baked->RasterizerDensity);
+			HashValue(Atlas->TexData->Format);
+			return Key;
+		}
+
+		static constexpr uint32 FileMagic = 0x47434749; // 'IGCG'
+		static constexpr uint32 FileVersion = 2;
+
+		TMap<uint64, FCachedSource> Sources;
+		TMap<const void*, uint64> FontDataHashes;
+		SIZE_T MemoryUsage = 0;
+		bool bIsDirty = false;
+	};
+}
@@ -0,0 +1,352 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#pragma once
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Glyph Instances"), STAT_ImGui_GlyphInstances, STATGROUP_ImGui);
+
+namespace ImGuiUtils
+{
+	// splits draw commands into indexed triangles and instanced glyph quads, and compacts the vertex/index data left for the indexed draws
+	// glyph quads are the ones written by ImDrawList::PrimRectUV (text, images), quads using the white pixel (rect fills) are not instanced
+	// NOTE: no RHI dependency, the widget drawer uploads the output (and benchmarks can measure it offscreen)
+	class FImGuiGlyphInstances : FNoncopyable
+	{
+	public:
+		// one instance per glyph quad, matches `GlyphInstances` in ImGuiShader.usf
+		struct FGlyphInstance
+		{
+			// top left corner
+			float X = 0.f;
+			float Y = 0.f;
+			// index into glyph rects
+			uint32 RectIndex = 0;
+			ImU32 Color = 0;
+		};
+		static_assert(sizeof(FGlyphInstance) == 16);
+
+		// quad size and atlas UVs, matches `GlyphRects` in ImGuiShader.usf (2 float4s per rect)
+		struct FGlyphRect
+		{
+			float Width = 0.f;
+			float Height = 0.f;
+			float Unused[2] = { 0.f, 0.f };
+			ImVec2 UV0;
+			ImVec2 UV1;
+
+			bool operator==(const FGlyphRect& Other) const
+			{
+				return Width == Other.Width && Height == Other.Height && UV0 == Other.UV0 && UV1 == Other.UV1;
+			}
+
+			friend uint32 GetTypeHash(const FGlyphRect& Rect)
+			{
+				return FCrc::MemCrc32(&Rect, sizeof(FGlyphRect));
+			}
+		};
+		static_assert(sizeof(FGlyphRect) == 32);
+
+		// part of a draw command, either indexed (NumInstances == 0) or instanced
+		struct FDrawSegment
+		{
+			// offsets in the uploaded buffers
+			uint32 BaseVertex = 0;
+			uint32 FirstIndex = 0;
+			uint32 NumIndices = 0;
+			uint32 FirstInstance = 0;
+			uint32 NumInstances = 0;
+
+			// source range in the draw list
+			uint32 SrcVtxOffset = 0;
+			uint32 SrcIdxOffset = 0;
+		};
+
+		void Build(const ImDrawData* DrawData, bool bInstanceGlyphs, int32 MinRunLength)
+		{
+			Segments.Reset();
+			CmdFirstSegment.Reset();
+			Instances.Reset();
+			Rects.Reset();
+			RectIndices.Reset();
+			DrawLists.Reset();
+			KeptVertices.Reset();
+			NumVertices = 0;
+			NumIndices = 0;
+
+			MinRunLength = FMath::Max(MinRunLength, 1);
+			for (const ImDrawList* CmdList : DrawData->CmdLists)
+			{
+				// ImGuiShapes quads look like glyph quads but are expanded by their own shaders
+				// NOTE: shape rendering callbacks only cover the draw list they were added to
+				bool bShapeRendering = false;
+
+				FDrawListInfo& DrawListInfo = DrawLists.AddDefaulted_GetRef();
+				DrawListInfo.FirstSegment = Segments.Num();
+
+				const int32 NumDrawListInstances = Instances.Num();
+				uint32 NumDrawListIndices = 0;
+				for (const ImDrawCmd& DrawCmd : CmdList->CmdBuffer)
+				{
+					CmdFirstSegment.Add(Segments.Num());
+					if (DrawCmd.UserCallback == ImDrawCallback_SetShapeRendering)
+					{
+						bShapeRendering = (DrawCmd.UserCallbackData != nullptr);
+					}
+					if (DrawCmd.UserCallback != NULL || DrawCmd.ElemCount == 0)
+					{
+						continue;
+					}
+
+					const uint32 IdxEnd = DrawCmd.IdxOffset + DrawCmd.ElemCount;
+					uint32 TriangleStart = DrawCmd.IdxOffset;
+					uint32 IdxOffset = DrawCmd.IdxOffset;
+					while (bInstanceGlyphs && !bShapeRendering && IdxOffset < IdxEnd)
+					{
+						uint32 RunEnd = IdxOffset;
+						while (RunEnd + 6 <= IdxEnd && IsGlyphQuad(CmdList, DrawCmd.VtxOffset, RunEnd))
+						{
+							RunEnd += 6;
+						}
+
+						const int32 RunLength = (RunEnd - IdxOffset) / 6;
+						if (RunLength < MinRunLength)
+						{
+							// short runs stay indexed, not worth a draw call
+							IdxOffset = (RunEnd > IdxOffset) ? RunEnd : IdxOffset + 3;
+							continue;
+						}
+
+						if (DrawListInfo.KeptVerticesOffset == INDEX_NONE)
+						{
+							DrawListInfo.KeptVerticesOffset = KeptVertices.Num();
+							KeptVertices.AddUninitialized(CmdList->VtxBuffer.Size + 1);
+							FMemory::Memset(KeptVertices.GetData() + DrawListInfo.KeptVerticesOffset, 1, CmdList->VtxBuffer.Size * sizeof(int32));
+						}
+						int32* KeptVertex = KeptVertices.GetData() + DrawListInfo.KeptVerticesOffset;
+
+						AddIndexedSegment(DrawCmd.VtxOffset, TriangleStart, IdxOffset - TriangleStart, NumDrawListIndices);
+
+						FDrawSegment& Segment = Segments.AddDefaulted_GetRef();
+						Segment.FirstInstance = Instances.Num();
+						Segment.NumInstances = RunLength;
+						for (; IdxOffset < RunEnd; IdxOffset += 6)
+						{
+							const uint32 VertexIndex = DrawCmd.VtxOffset + CmdList->IdxBuffer[IdxOffset];
+							AddInstance(CmdList->VtxBuffer.Data + VertexIndex);
+
+							KeptVertex[VertexIndex + 0] = 0;
+							KeptVertex[VertexIndex + 1] = 0;
+							KeptVertex[VertexIndex + 2] = 0;
+							KeptVertex[VertexIndex + 3] = 0;
+						}
+						TriangleStart = IdxOffset;
+					}
+					AddIndexedSegment(DrawCmd.VtxOffset, TriangleStart, IdxEnd - TriangleStart, NumDrawListIndices);
+				}
+
+				// exclusive prefix sum, vertex index -> index in the compacted vertex buffer
+				if (DrawListInfo.KeptVerticesOffset != INDEX_NONE)
+				{
+					int32* KeptVertex = KeptVertices.GetData() + DrawListInfo.KeptVerticesOffset;
+					int32 NumKeptVertices = 0;
+					for (int32 VertexIndex = 0; VertexIndex < CmdList->VtxBuffer.Size; ++VertexIndex)
+					{
+						const int32 bIsKept = KeptVertex[VertexIndex] != 0 ? 1 : 0;
+						KeptVertex[VertexIndex] = NumKeptVertices;
+						NumKeptVertices += bIsKept;
+					}
+					KeptVertex[CmdList->VtxBuffer.Size] = NumKeptVertices;
+					DrawListInfo.NumVertices = NumKeptVertices;
+					DrawListInfo.NumIndices = NumDrawListIndices;
+				}
+				else
+				{
+					DrawListInfo.NumVertices = CmdList->VtxBuffer.Size;
+					DrawListInfo.NumIndices = CmdList->IdxBuffer.Size;
+				}
+
+				for (int32 SegmentIndex = DrawListInfo.FirstSegment; SegmentIndex < Segments.Num(); ++SegmentIndex)
+				{
+					FDrawSegment& Segment = Segments[SegmentIndex];
+					if (Segment.NumInstances > 0)
+					{
+						continue;
+					}
+
+					if (DrawListInfo.KeptVerticesOffset != INDEX_NONE)
+					{
+						Segment.BaseVertex = NumVertices + KeptVertices[DrawListInfo.KeptVerticesOffset + Segment.SrcVtxOffset];
+						Segment.FirstIndex += NumIndices;
+					}
+					else
+					{
+						// uploaded as is
+						Segment.BaseVertex = NumVertices + Segment.SrcVtxOffset;
+						Segment.FirstIndex = NumIndices + Segment.SrcIdxOffset;
+					}
+				}
+				NumVertices += DrawListInfo.NumVertices;
+				NumIndices += DrawListInfo.NumIndices;
+
+				INC_DWORD_STAT_BY(STAT_ImGui_GlyphInstances, Instances.Num() - NumDrawListInstances);
+			}
+			CmdFirstSegment.Add(Segments.Num());
+		}
+
+		void WriteVertices(const ImDrawData* DrawData, ImDrawVert* VertexDst) const
+		{
+			for (int32 CmdListIndex = 0; CmdListIndex < DrawData->CmdLists.Size; ++CmdListIndex)
+			{
+				const ImDrawList* CmdList = DrawData->CmdLists[CmdListIndex];
+				const FDrawListInfo& DrawListInfo = DrawLists[CmdListIndex];
+				if (DrawListInfo.KeptVerticesOffset == INDEX_NONE)
+				{
+					FMemory::Memcpy(VertexDst, CmdList->VtxBuffer.Data, CmdList->VtxBuffer.Size * sizeof(ImDrawVert));
+				}
+				else
+				{
+					// copy spans of kept vertices
+					const int32* KeptVertex = KeptVertices.GetData() + DrawListInfo.KeptVerticesOffset;
+					int32 SpanStart = INDEX_NONE;
+					for (int32 VertexIndex = 0; VertexIndex <= CmdList->VtxBuffer.Size; ++VertexIndex)
+					{
+						const bool bIsKept = (VertexIndex < CmdList->VtxBuffer.Size) && (KeptVertex[VertexIndex + 1] != KeptVertex[VertexIndex]);
+						if (bIsKept && SpanStart == INDEX_NONE)
+						{
+							SpanStart = VertexIndex;
+						}
+						else if (!bIsKept && SpanStart != INDEX_NONE)
+						{
+							FMemory::Memcpy(VertexDst + KeptVertex[SpanStart], CmdList->VtxBuffer.Data + SpanStart, (VertexIndex - SpanStart) * sizeof(ImDrawVert));
+							SpanStart = INDEX_NONE;
+						}
+					}
+				}
+				VertexDst += DrawListInfo.NumVertices;
+			}
+		}
+
+		void WriteIndices(const ImDrawData* DrawData, ImDrawIdx* IndexDst) const
+		{
+			for (int32 CmdListIndex = 0; CmdListIndex < DrawData->CmdLists.Size; ++CmdListIndex)
+			{
+				const ImDrawList* CmdList = DrawData->CmdLists[CmdListIndex];
+				const FDrawListInfo& DrawListInfo = DrawLists[CmdListIndex];
+				if (DrawListInfo.KeptVerticesOffset == INDEX_NONE)
+				{
+					FMemory::Memcpy(IndexDst, CmdList->IdxBuffer.Data, CmdList->IdxBuffer.Size * sizeof(ImDrawIdx));
+				}
+				else
+				{
+					// indices stay relative to the (compacted) vertex offset of their command, so they still fit in ImDrawIdx
+					const int32* KeptVertex = KeptVertices.GetData() + DrawListInfo.KeptVerticesOffset;
+					const int32 LastSegment = (CmdListIndex + 1 < DrawLists.Num()) ? DrawLists[CmdListIndex + 1].FirstSegment : Segments.Num();
+					ImDrawIdx* DrawListIndexDst = IndexDst;
+					for (int32 SegmentIndex = DrawListInfo.FirstSegment; SegmentIndex < LastSegment; ++SegmentIndex)
+					{
+						const FDrawSegment& Segment = Segments[SegmentIndex];
+						const ImDrawIdx* IndexSrc = CmdList->IdxBuffer.Data + Segment.SrcIdxOffset;
+						const int32 VertexOffset = KeptVertex[Segment.SrcVtxOffset];
+						for (uint32 Index = 0; Index < Segment.NumIndices; ++Index)
+						{
+							*DrawListIndexDst++ = (ImDrawIdx)(KeptVertex[Segment.SrcVtxOffset + IndexSrc[Index]] - VertexOffset);
+						}
+					}
+				}
+				IndexDst += DrawListInfo.NumIndices;
+			}
+		}
+
+		// segments of a draw command, CmdIndex counts the commands (including callbacks) of all draw lists
+		TArrayView<const FDrawSegment> GetCmdSegments(int32 CmdIndex) const
+		{
+			return TArrayView<const FDrawSegment>(Segments.GetData() + CmdFirstSegment[CmdIndex], CmdFirstSegment[CmdIndex + 1] - CmdFirstSegment[CmdIndex]);
+		}
+
+		const TArray<FGlyphInstance>& GetInstances() const { return Instances; }
+		const TArray<FGlyphRect>& GetRects() const { return Rects; }
+		uint32 GetNumVertices() const { return NumVertices; }
+		uint32 GetNumIndices() const { return NumIndices; }
+
+		// bytes uploaded for the draw data
+		SIZE_T GetUploadSize() const
+		{
+			return NumVertices * sizeof(ImDrawVert) + NumIndices * sizeof(ImDrawIdx) + Instances.Num() * sizeof(FGlyphInstance) + Rects.Num() * sizeof(FGlyphRect);
+		}
+
+	private:
+		struct FDrawListInfo
+		{
+			int32 FirstSegment = 0;
+			// INDEX_NONE when nothing was instanced (vertices/indices are copied as is)
+			int32 KeptVerticesOffset = INDEX_NONE;
+			uint32 NumVertices = 0;
+			uint32 NumIndices = 0;
+		};
+
+		// 2 triangles sharing the first vertex of an axis aligned quad (ImDrawList::PrimRectUV)
+		static bool IsGlyphQuad(const ImDrawList* CmdList, uint32 VtxOffset, uint32 IdxOffset)
+		{
+			const ImDrawIdx* Index = CmdList->IdxBuffer.Data + IdxOffset;
+			const uint32 A = Index[0];
+			if (Index[1] != A + 1 || Index[2] != A + 2 || Index[3] != A || Index[4] != A + 2 || Index[5] != A + 3 || (VtxOffset + A + 3) >= (uint32)CmdList->VtxBuffer.Size)
+			{
+				return false;
+			}
+
+			const ImDrawVert* Vertex = CmdList->VtxBuffer.Data + VtxOffset + A;
+			return Vertex[0].pos.y == Vertex[1].pos.y && Vertex[1].pos.x == Vertex[2].pos.x && Vertex[2].pos.y == Vertex[3].pos.y && Vertex[3].pos.x == Vertex[0].pos.x &&
+				Vertex[0].uv.y == Vertex[1].uv.y && Vertex[1].uv.x == Vertex[2].uv.x && Vertex[2].uv.y == Vertex[3].uv.y && Vertex[3].uv.x == Vertex[0].uv.x &&
+				Vertex[0].col == Vertex[1].col && Vertex[0].col == Vertex[2].col && Vertex[0].col == Vertex[3].col &&
+				Vertex[0].uv.x != Vertex[2].uv.x && Vertex[0].uv.y != Vertex[2].uv.y;
+		}
+
+		void AddInstance(const ImDrawVert* Vertex)
+		{
+			// quantize the size, glyphs at fractional positions would otherwise end up with slightly different rects
+			FGlyphRect Rect;
+			Rect.Width = FMath::RoundToFloat((Vertex[2].pos.x - Vertex[0].pos.x) * 64.f) / 64.f;
+			Rect.Height = FMath::RoundToFloat((Vertex[2].pos.y - Vertex[0].pos.y) * 64.f) / 64.f;
+			Rect.UV0 = Vertex[0].uv;
+			Rect.UV1 = Vertex[2].uv;
+
+			uint32& RectIndex = RectIndices.FindOrAdd(Rect, MAX_uint32);
+			if (RectIndex == MAX_uint32)
+			{
+				RectIndex = Rects.Add(Rect);
+			}
+
+			FGlyphInstance& Instance = Instances.AddDefaulted_GetRef();
+			Instance.X = Vertex[0].pos.x;
+			Instance.Y = Vertex[0].pos.y;
+			Instance.RectIndex = RectIndex;
+			Instance.Color = Vertex[0].col;
+		}
+
+		void AddIndexedSegment(uint32 VtxOffset, uint32 IdxOffset, uint32 ElemCount, uint32& NumDrawListIndices)
+		{
+			if (ElemCount == 0)
+			{
+				return;
+			}
+
+			FDrawSegment& Segment = Segments.AddDefaulted_GetRef();
+			Segment.SrcVtxOffset = VtxOffset;
+			Segment.SrcIdxOffset = IdxOffset;
+			Segment.NumIndices = ElemCount;
+			// offset in the compacted index buffer of the draw list, unused when it is uploaded as is
+			Segment.FirstIndex = NumDrawListIndices;
+			NumDrawListIndices += ElemCount;
+		}
+
+		TArray<FDrawSegment> Segments;
+		TArray<int32> CmdFirstSegment;
+		TArray<FGlyphInstance> Instances;
+		TArray<FGlyphRect> Rects;
+		TMap<FGlyphRect, uint32> RectIndices;
+		TArray<FDrawListInfo> DrawLists;
+		// per draw list (that has instances): number of kept vertices before each vertex, +1 entry for the total
+		TArray<int32> KeptVertices;
+		uint32 NumVertices = 0;
+		uint32 NumIndices = 0;
+	};
+}
@@ -3,168 +3,302 @@
 #include "Input/Events.h"
 #include "InputCoreTypes.h"
 
+// queued: slate input events received by the widgets (once per event, however many ImGui events it turns into), applied: events left for ImGui::NewFrame
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input Events Queued"), STAT_ImGui_InputEventsQueued, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Input Events Applied"), STAT_ImGui_InputEventsApplied, STATGROUP_ImGui);
+
 namespace ImGuiUtils
 {
-	FORCEINLINE static ImGuiKey UnrealToImGuiKey(FName Keyname)
+	// flat FName -> ImGuiKey table keyed on the name comparison index, no FName hashing or string compares in the input path
+	// NOTE: comparison indices are handles into the name pool (large and sparse), they can't index an array directly so
+	// they are spread over a small power of two table instead (open addressing, a probe or two per lookup)
+	struct FKeyTranslationTable
+	{
+		void Build()
+		{
+			const TPair<FName, ImGuiKey> KeyMappings[] =
+			{
+				{ EKeys::BackSpace.GetFName(), ImGuiKey_Backspace },
+				{ EKeys::Tab.GetFName(), ImGuiKey_Tab },
+				{ EKeys::Enter.GetFName(), ImGuiKey_Enter },
+				{ EKeys::Pause.GetFName(), ImGuiKey_Pause },
+
+				{ EKeys::CapsLock.GetFName(), ImGuiKey_CapsLock },
+				{ EKeys::Escape.GetFName(), ImGuiKey_Escape },
+				{ EKeys::SpaceBar.GetFName(), ImGuiKey_Space },
+				{ EKeys::PageUp.GetFName(), ImGuiKey_PageUp },
+				{ EKeys::PageDown.GetFName(), ImGuiKey_PageDown },
+				{ EKeys::End.GetFName(), ImGuiKey_End },
+				{ EKeys::Home.GetFName(), ImGuiKey_Home },
+
+				{ EKeys::Left.GetFName(), ImGuiKey_LeftArrow },
+				{ EKeys::Up.GetFName(), ImGuiKey_UpArrow },
+				{ EKeys::Right.GetFName(), ImGuiKey_RightArrow },
+				{ EKeys::Down.GetFName(), ImGuiKey_DownArrow },
+
+				{ EKeys::Insert.GetFName(), ImGuiKey_Insert },
+				{ EKeys::Delete.GetFName(), ImGuiKey_Delete },
+
+				{ EKeys::Zero.GetFName(), ImGuiKey_0 },
+				{ EKeys::One.GetFName(), ImGuiKey_1 },
+				{ EKeys::Two.GetFName(), ImGuiKey_2 },
+				{ EKeys::Three.GetFName(), ImGuiKey_3 },
+				{ EKeys::Four.GetFName(), ImGuiKey_4 },
+				{ EKeys::Five.GetFName(), ImGuiKey_5 },
+				{ EKeys::Six.GetFName(), ImGuiKey_6 },
+				{ EKeys::Seven.GetFName(), ImGuiKey_7 },
+				{ EKeys::Eight.GetFName(), ImGuiKey_8 },
+				{ EKeys::Nine.GetFName(), ImGuiKey_9 },
+
+				{ EKeys::A.GetFName(), ImGuiKey_A },
+				{ EKeys::B.GetFName(), ImGuiKey_B },
+				{ EKeys::C.GetFName(), ImGuiKey_C },
+				{ EKeys::D.GetFName(), ImGuiKey_D },
+				{ EKeys::E.GetFName(), ImGuiKey_E },
+				{ EKeys::F.GetFName(), ImGuiKey_F },
+				{ EKeys::G.GetFName(), ImGuiKey_G },
+				{ EKeys::H.GetFName(), ImGuiKey_H },
+				{ EKeys::I.GetFName(), ImGuiKey_I },
+				{ EKeys::J.GetFName(), ImGuiKey_J },
+				{ EKeys::K.GetFName(), ImGuiKey_K },
+				{ EKeys::L.GetFName(), ImGuiKey_L },
+				{ EKeys::M.GetFName(), ImGuiKey_M },
+				{ EKeys::N.GetFName(), ImGuiKey_N },
+				{ EKeys::O.GetFName(), ImGuiKey_O },
+				{ EKeys::P.GetFName(), ImGuiKey_P },
+				{ EKeys::Q.GetFName(), ImGuiKey_Q },
+				{ EKeys::R.GetFName(), ImGuiKey_R },
+				{ EKeys::S.GetFName(), ImGuiKey_S },
+				{ EKeys::T.GetFName(), ImGuiKey_T },
+				{ EKeys::U.GetFName(), ImGuiKey_U },
+				{ EKeys::V.GetFName(), ImGuiKey_V },
+				{ EKeys::W.GetFName(), ImGuiKey_W },
+				{ EKeys::X.GetFName(), ImGuiKey_X },
+				{ EKeys::Y.GetFName(), ImGuiKey_Y },
+				{ EKeys::Z.GetFName(), ImGuiKey_Z },
+
+				{ EKeys::NumPadZero.GetFName(), ImGuiKey_Keypad0 },
+				{ EKeys::NumPadOne.GetFName(), ImGuiKey_Keypad1 },
+				{ EKeys::NumPadTwo.GetFName(), ImGuiKey_Keypad2 },
+				{ EKeys::NumPadThree.GetFName(), ImGuiKey_Keypad3 },
+				{ EKeys::NumPadFour.GetFName(), ImGuiKey_Keypad4 },
+				{ EKeys::NumPadFive.GetFName(), ImGuiKey_Keypad5 },
+				{ EKeys::NumPadSix.GetFName(), ImGuiKey_Keypad6 },
+				{ EKeys::NumPadSeven.GetFName(), ImGuiKey_Keypad7 },
+				{ EKeys::NumPadEight.GetFName(), ImGuiKey_Keypad8 },
+				{ EKeys::NumPadNine.GetFName(), ImGuiKey_Keypad9 },
+
+				{ EKeys::Multiply.GetFName(), ImGuiKey_KeypadMultiply },
+				{ EKeys::Add.GetFName(), ImGuiKey_KeypadAdd },
+				{ EKeys::Subtract.GetFName(), ImGuiKey_KeypadSubtract },
+				{ EKeys::Decimal.GetFName(), ImGuiKey_KeypadDecimal },
+				{ EKeys::Divide.GetFName(), ImGuiKey_KeypadDivide },
+
+				{ EKeys::F1.GetFName(), ImGuiKey_F1 },
+				{ EKeys::F2.GetFName(), ImGuiKey_F2 },
+				{ EKeys::F3.GetFName(), ImGuiKey_F3 },
+				{ EKeys::F4.GetFName(), ImGuiKey_F4 },
+				{ EKeys::F5.GetFName(), ImGuiKey_F5 },
+				{ EKeys::F6.GetFName(), ImGuiKey_F6 },
+				{ EKeys::F7.GetFName(), ImGuiKey_F7 },
+				{ EKeys::F8.GetFName(), ImGuiKey_F8 },
+				{ EKeys::F9.GetFName(), ImGuiKey_F9 },
+				{ EKeys::F10.GetFName(), ImGuiKey_F10 },
+				{ EKeys::F11.GetFName(), ImGuiKey_F11 },
+				{ EKeys::F12.GetFName(), ImGuiKey_F12 },
+
+				{ EKeys::NumLock.GetFName(), ImGuiKey_NumLock },
+				{ EKeys::ScrollLock.GetFName(), ImGuiKey_ScrollLock },
+
+				{ EKeys::LeftShift.GetFName(), ImGuiKey_LeftShift },
+				{ EKeys::RightShift.GetFName(), ImGuiKey_RightShift },
+				{ EKeys::LeftControl.GetFName(), ImGuiKey_LeftCtrl },
+				{ EKeys::RightControl.GetFName(), ImGuiKey_RightCtrl },
+				{ EKeys::LeftAlt.GetFName(), ImGuiKey_LeftAlt },
+				{ EKeys::RightAlt.GetFName(), ImGuiKey_RightAlt },
+				{ EKeys::LeftCommand.GetFName(), ImGuiKey_None },
+				{ EKeys::RightCommand.GetFName(), ImGuiKey_None },
+
+				{ EKeys::Semicolon.GetFName(), ImGuiKey_Semicolon },
+				{ EKeys::Equals.GetFName(), ImGuiKey_Equal },
+				{ EKeys::Comma.GetFName(), ImGuiKey_Comma },
+				{ EKeys::Underscore.GetFName(), ImGuiKey_None },
+				{ EKeys::Hyphen.GetFName(), ImGuiKey_None },
+				{ EKeys::Period.GetFName(), ImGuiKey_Period },
+				{ EKeys::Slash.GetFName(), ImGuiKey_Slash },
+				{ EKeys::Tilde.GetFName(), ImGuiKey_None },
+				{ EKeys::LeftBracket.GetFName(), ImGuiKey_LeftBracket },
+				{ EKeys::Backslash.GetFName(), ImGuiKey_Backslash },
+				{ EKeys::RightBracket.GetFName(), ImGuiKey_RightBracket },
+				{ EKeys::Apostrophe.GetFName(), ImGuiKey_Apostrophe },
+
+				{ EKeys::Ampersand.GetFName(), ImGuiKey_None },
+				{ EKeys::Asterix.GetFName(), ImGuiKey_None },
+				{ EKeys::Caret.GetFName(), ImGuiKey_None },
+				{ EKeys::Colon.GetFName(), ImGuiKey_None },
+				{ EKeys::Dollar.GetFName(), ImGuiKey_None },
+				{ EKeys::Exclamation.GetFName(), ImGuiKey_None },
+				{ EKeys::LeftParantheses.GetFName(), ImGuiKey_None },
+				{ EKeys::RightParantheses.GetFName(), ImGuiKey_None },
+				{ EKeys::Quote.GetFName(), ImGuiKey_None },
+
+				{ EKeys::Gamepad_LeftThumbstick.GetFName(), ImGuiKey_GamepadL3 },
+				{ EKeys::Gamepad_RightThumbstick.GetFName(), ImGuiKey_GamepadR3 },
+				{ EKeys::Gamepad_Special_Left.GetFName(), ImGuiKey_GamepadBack },
+				{ EKeys::Gamepad_Special_Left_X.GetFName(), ImGuiKey_None },
+				{ EKeys::Gamepad_Special_Left_Y.GetFName(), ImGuiKey_None },
+				{ EKeys::Gamepad_Special_Right.GetFName(), ImGuiKey_GamepadStart },
+				{ EKeys::Gamepad_FaceButton_Bottom.GetFName(), ImGuiKey_GamepadFaceDown },
+				{ EKeys::Gamepad_FaceButton_Right.GetFName(), ImGuiKey_GamepadFaceRight },
+				{ EKeys::Gamepad_FaceButton_Left.GetFName(), ImGuiKey_GamepadFaceLeft },
+				{ EKeys::Gamepad_FaceButton_Top.GetFName(), ImGuiKey_GamepadFaceUp },
+				{ EKeys::Gamepad_LeftShoulder.GetFName(), ImGuiKey_GamepadL1 },
+				{ EKeys::Gamepad_RightShoulder.GetFName(), ImGuiKey_GamepadR1 },
+				{ EKeys::Gamepad_LeftTrigger.GetFName(), ImGuiKey_GamepadL2 },
+				{ EKeys::Gamepad_RightTrigger.GetFName(), ImGuiKey_GamepadR2 },
+				{ EKeys::Gamepad_DPad_Up.GetFName(), ImGuiKey_GamepadDpadUp },
+				{ EKeys::Gamepad_DPad_Down.GetFName(), ImGuiKey_GamepadDpadDown },
+				{ EKeys::Gamepad_DPad_Right.GetFName(), ImGuiKey_GamepadDpadRight },
+				{ EKeys::Gamepad_DPad_Left.GetFName(), ImGuiKey_GamepadDpadLeft },
+
+				{ EKeys::Gamepad_LeftStick_Up.GetFName(), ImGuiKey_GamepadLStickUp },
+				{ EKeys::Gamepad_LeftStick_Down.GetFName(), ImGuiKey_GamepadLStickDown },
+				{ EKeys::Gamepad_LeftStick_Right.GetFName(), ImGuiKey_GamepadLStickRight },
+				{ EKeys::Gamepad_LeftStick_Left.GetFName(), ImGuiKey_GamepadLStickLeft },
+
+				{ EKeys::Gamepad_RightStick_Up.GetFName(), ImGuiKey_GamepadRStickUp },
+				{ EKeys::Gamepad_RightStick_Down.GetFName(), ImGuiKey_GamepadRStickDown },
+				{ EKeys::Gamepad_RightStick_Right.GetFName(), ImGuiKey_GamepadRStickRight },
+				{ EKeys::Gamepad_RightStick_Left.GetFName(), ImGuiKey_GamepadRStickLeft },
+			};
+
+			// at most a quarter full, keeps probe sequences short
+			const int32 NumSlots = FMath::RoundUpToPowerOfTwo(UE_ARRAY_COUNT(KeyMappings) * 4);
+			SlotShift = 32 - FMath::FloorLog2(NumSlots);
+			SlotNameIds.Init(EmptySlot, NumSlots);
+			SlotKeys.Init(ImGuiKey_None, NumSlots);
+
+			for (const TPair<FName, ImGuiKey>& KeyMapping : KeyMappings)
+			{
+				// unmapped keys resolve to ImGuiKey_None anyways
+				if (KeyMapping.Value != ImGuiKey_None && ensure(KeyMapping.Key.GetNumber() == NAME_NO_NUMBER_INTERNAL))
+				{
+					const uint32 NameId = KeyMapping.Key.GetComparisonIndex().ToUnstableInt();
+					uint32 Slot = GetFirstSlot(NameId);
+					while (SlotNameIds[Slot] != EmptySlot && SlotNameIds[Slot] != NameId)
+					{
+						Slot = GetNextSlot(Slot);
+					}
+					SlotNameIds[Slot] = NameId;
+					SlotKeys[Slot] = KeyMapping.Value;
+				}
+			}
+		}
+
+		bool IsBuilt() const { return !SlotNameIds.IsEmpty(); }
+
+		FORCEINLINE ImGuiKey Find(FName KeyName) const
+		{
+			if (KeyName.GetNumber() != NAME_NO_NUMBER_INTERNAL)
+			{
+				return ImGuiKey_None;
+			}
+
+			const uint32 NameId = KeyName.GetComparisonIndex().ToUnstableInt();
+			for (uint32 Slot = GetFirstSlot(NameId); SlotNameIds[Slot] != EmptySlot; Slot = GetNextSlot(Slot))
+			{
+				if (SlotNameIds[Slot] == NameId)
+				{
+					return SlotKeys[Slot];
+				}
+			}
+			return ImGuiKey_None;
+		}
+
+	private:
+		// NAME_None, never a key name
+		static constexpr uint32 EmptySlot = 0;
+
+		// fibonacci hashing, consecutive name ids (keys are registered back to back) land far apart
+		FORCEINLINE uint32 GetFirstSlot(uint32 NameId) const { return (NameId * 0x9E3779B9u) >> SlotShift; }
+		FORCEINLINE uint32 GetNextSlot(uint32 Slot) const { return (Slot + 1) & (SlotNameIds.Num() - 1); }
+
+		TArray<uint32> SlotNameIds;
+		TArray<ImGuiKey> SlotKeys;
+		int32 SlotShift = 32;
+	};
+	static FKeyTranslationTable KeyTranslationTable;
+
+	FORCEINLINE static ImGuiKey UnrealToImGuiKey(FName KeyName)
+	{
+		// NOTE: fallback for when widgets are created before module startup (shouldn't happen)
+		if (UNLIKELY(!KeyTranslationTable.IsBuilt()))
+		{
+			KeyTranslationTable.Build();
+		}
+		return KeyTranslationTable.Find(KeyName);
+	}
+
+	// analog axes slate reports through OnAnalogValueChanged (not in the key table), batched per frame by the widgets
+	enum class EGamepadAxis : uint8
+	{
+		LeftX,
+		LeftY,
+		RightX,
+		RightY,
+		LeftTrigger,
+		RightTrigger,
+		Count
+	};
+
+	// returns INDEX_NONE for keys that aren't gamepad axes
+	FORCEINLINE static int32 UnrealToGamepadAxis(const FKey& Key)
 	{
-		static const TMap<FName, ImGuiKey> KeyMap =
+		static const FKey AxisKeys[] =
 		{
-			{ EKeys::BackSpace.GetFName(), ImGuiKey_Backspace },
-			{ EKeys::Tab.GetFName(), ImGuiKey_Tab },
-			{ EKeys::Enter.GetFName(), ImGuiKey_Enter },
-			{ EKeys::Pause.GetFName(), ImGuiKey_Pause },
-
-			{ EKeys::CapsLock.GetFName(), ImGuiKey_CapsLock },
-			{ EKeys::Escape.GetFName(), ImGuiKey_Escape },
-			{ EKeys::SpaceBar.GetFName(), ImGuiKey_Space },
-			{ EKeys::PageUp.GetFName(), ImGuiKey_PageUp },
-			{ EKeys::PageDown.GetFName(), ImGuiKey_PageDown },
-			{ EKeys::End.GetFName(), ImGuiKey_End },
-			{ EKeys::Home.GetFName(), ImGuiKey_Home },
-
-			{ EKeys::Left.GetFName(), ImGuiKey_LeftArrow },
-			{ EKeys::Up.GetFName(), ImGuiKey_UpArrow },
-			{ EKeys::Right.GetFName(), ImGuiKey_RightArrow },
-			{ EKeys::Down.GetFName(), ImGuiKey_DownArrow },
-
-			{ EKeys::Insert.GetFName(), ImGuiKey_Insert },
-			{ EKeys::Delete.GetFName(), ImGuiKey_Delete },
-
-			{ EKeys::Zero.GetFName(), ImGuiKey_0 },
-			{ EKeys::One.GetFName(), ImGuiKey_1 },
-			{ EKeys::Two.GetFName(), ImGuiKey_2 },
-			{ EKeys::Three.GetFName(), ImGuiKey_3 },
-			{ EKeys::Four.GetFName(), ImGuiKey_4 },
-			{ EKeys::Five.GetFName(), ImGuiKey_5 },
-			{ EKeys::Six.GetFName(), ImGuiKey_6 },
-			{ EKeys::Seven.GetFName(), ImGuiKey_7 },
-			{ EKeys::Eight.GetFName(), ImGuiKey_8 },
-			{ EKeys::Nine.GetFName(), ImGuiKey_9 },
-
-			{ EKeys::A.GetFName(), ImGuiKey_A },
-			{ EKeys::B.GetFName(), ImGuiKey_B },
-			{ EKeys::C.GetFName(), ImGuiKey_C },
-			{ EKeys::D.GetFName(), ImGuiKey_D },
-			{ EKeys::E.GetFName(), ImGuiKey_E },
-			{ EKeys::F.GetFName(), ImGuiKey_F },
-			{ EKeys::G.GetFName(), ImGuiKey_G },
-			{ EKeys::H.GetFName(), ImGuiKey_H },
-			{ EKeys::I.GetFName(), ImGuiKey_I },
-			{ EKeys::J.GetFName(), ImGuiKey_J },
-			{ EKeys::K.GetFName(), ImGuiKey_K },
-			{ EKeys::L.GetFName(), ImGuiKey_L },
-			{ EKeys::M.GetFName(), ImGuiKey_M },
-			{ EKeys::N.GetFName(), ImGuiKey_N },
-			{ EKeys::O.GetFName(), ImGuiKey_O },
-			{ EKeys::P.GetFName(), ImGuiKey_P },
-			{ EKeys::Q.GetFName(), ImGuiKey_Q },
-			{ EKeys::R.GetFName(), ImGuiKey_R },
-			{ EKeys::S.GetFName(), ImGuiKey_S },
-			{ EKeys::T.GetFName(), ImGuiKey_T },
-			{ EKeys::U.GetFName(), ImGuiKey_U },
-			{ EKeys::V.GetFName(), ImGuiKey_V },
-			{ EKeys::W.GetFName(), ImGuiKey_W },
-			{ EKeys::X.GetFName(), ImGuiKey_X },
-			{ EKeys::Y.GetFName(), ImGuiKey_Y },
-			{ EKeys::Z.GetFName(), ImGuiKey_Z },
-
-			{ EKeys::NumPadZero.GetFName(), ImGuiKey_Keypad0 },
-			{ EKeys::NumPadOne.GetFName(), ImGuiKey_Keypad1 },
-			{ EKeys::NumPadTwo.GetFName(), ImGuiKey_Keypad2 },
-			{ EKeys::NumPadThree.GetFName(), ImGuiKey_Keypad3 },
-			{ EKeys::NumPadFour.GetFName(), ImGuiKey_Keypad4 },
-			{ EKeys::NumPadFive.GetFName(), ImGuiKey_Keypad5 },
-			{ EKeys::NumPadSix.GetFName(), ImGuiKey_Keypad6 },
-			{ EKeys::NumPadSeven.GetFName(), ImGuiKey_Keypad7 },
-			{ EKeys::NumPadEight.GetFName(), ImGuiKey_Keypad8 },
-			{ EKeys::NumPadNine.GetFName(), ImGuiKey_Keypad9 },
-
-			{ EKeys::Multiply.GetFName(), ImGuiKey_KeypadMultiply },
-			{ EKeys::Add.GetFName(), ImGuiKey_KeypadAdd },
-			{ EKeys::Subtract.GetFName(), ImGuiKey_KeypadSubtract },
-			{ EKeys::Decimal.GetFName(), ImGuiKey_KeypadDecimal },
-			{ EKeys::Divide.GetFName(), ImGuiKey_KeypadDivide },
-
-			{ EKeys::F1.GetFName(), ImGuiKey_F1 },
-			{ EKeys::F2.GetFName(), ImGuiKey_F2 },
-			{ EKeys::F3.GetFName(), ImGuiKey_F3 },
-			{ EKeys::F4.GetFName(), ImGuiKey_F4 },
-			{ EKeys::F5.GetFName(), ImGuiKey_F5 },
-			{ EKeys::F6.GetFName(), ImGuiKey_F6 },
-			{ EKeys::F7.GetFName(), ImGuiKey_F7 },
-			{ EKeys::F8.GetFName(), ImGuiKey_F8 },
-			{ EKeys::F9.GetFName(), ImGuiKey_F9 },
-			{ EKeys::F10.GetFName(), ImGuiKey_F10 },
-			{ EKeys::F11.GetFName(), ImGuiKey_F11 },
-			{ EKeys::F12.GetFName(), ImGuiKey_F12 },
-
-			{ EKeys::NumLock.GetFName(), ImGuiKey_NumLock },
-			{ EKeys::ScrollLock.GetFName(), ImGuiKey_ScrollLock },
-
-			{ EKeys::LeftShift.GetFName(), ImGuiKey_LeftShift },
-			{ EKeys::RightShift.GetFName(), ImGuiKey_RightShift },
-			{ EKeys::LeftControl.GetFName(), ImGuiKey_LeftCtrl },
-			{ EKeys::RightControl.GetFName(), ImGuiKey_RightCtrl },
-			{ EKeys::LeftAlt.GetFName(), ImGuiKey_LeftAlt },
-			{ EKeys::RightAlt.GetFName(), ImGuiKey_RightAlt },
-			{ EKeys::LeftCommand.GetFName(), ImGuiKey_None },
-			{ EKeys::RightCommand.GetFName(), ImGuiKey_None },
-
-			{ EKeys::Semicolon.GetFName(), ImGuiKey_Semicolon },
-			{ EKeys::Equals.GetFName(), ImGuiKey_Equal },
-			{ EKeys::Comma.GetFName(), ImGuiKey_Comma },
-			{ EKeys::Underscore.GetFName(), ImGuiKey_None },
-			{ EKeys::Hyphen.GetFName(), ImGuiKey_None },
-			{ EKeys::Period.GetFName(), ImGuiKey_Period },
-			{ EKeys::Slash.GetFName(), ImGuiKey_Slash },
-			{ EKeys::Tilde.GetFName(), ImGuiKey_None },
-			{ EKeys::LeftBracket.GetFName(), ImGuiKey_LeftBracket },
-			{ EKeys::Backslash.GetFName(), ImGuiKey_Backslash },
-			{ EKeys::RightBracket.GetFName(), ImGuiKey_RightBracket },
-			{ EKeys::Apostrophe.GetFName(), ImGuiKey_Apostrophe },
-
-			{ EKeys::Ampersand.GetFName(), ImGuiKey_None },
-			{ EKeys::Asterix.GetFName(), ImGuiKey_None },
-			{ EKeys::Caret.GetFName(), ImGuiKey_None },
-			{ EKeys::Colon.GetFName(), ImGuiKey_None },
-			{ EKeys::Dollar.GetFName(), ImGuiKey_None },
-			{ EKeys::Exclamation.GetFName(), ImGuiKey_None },
-			{ EKeys::LeftParantheses.GetFName(), ImGuiKey_None },
-			{ EKeys::RightParantheses.GetFName(), ImGuiKey_None },
-			{ EKeys::Quote.GetFName(), ImGuiKey_None },
-
-			{ EKeys::Gamepad_LeftThumbstick.GetFName(), ImGuiKey_GamepadL3 },
-			{ EKeys::Gamepad_RightThumbstick.GetFName(), ImGuiKey_GamepadR3 },
-			{ EKeys::Gamepad_Special_Left.GetFName(), ImGuiKey_GamepadBack },
-			{ EKeys::Gamepad_Special_Left_X.GetFName(), ImGuiKey_None },
-			{ EKeys::Gamepad_Special_Left_Y.GetFName(), ImGuiKey_None },
-			{ EKeys::Gamepad_Special_Right.GetFName(), ImGuiKey_GamepadStart },
-			{ EKeys::Gamepad_FaceButton_Bottom.GetFName(), ImGuiKey_GamepadFaceDown },
-			{ EKeys::Gamepad_FaceButton_Right.GetFName(), ImGuiKey_GamepadFaceRight },
-			{ EKeys::Gamepad_FaceButton_Left.GetFName(), ImGuiKey_GamepadFaceLeft },
-			{ EKeys::Gamepad_FaceButton_Top.GetFName(), ImGuiKey_GamepadFaceUp },
-			{ EKeys::Gamepad_LeftShoulder.GetFName(), ImGuiKey_GamepadL1 },
-			{ EKeys::Gamepad_RightShoulder.GetFName(), ImGuiKey_GamepadR1 },
-			{ EKeys::Gamepad_LeftTrigger.GetFName(), ImGuiKey_GamepadL2 },
-			{ EKeys::Gamepad_RightTrigger.GetFName(), ImGuiKey_GamepadR2 },
-			{ EKeys::Gamepad_DPad_Up.GetFName(), ImGuiKey_GamepadDpadUp },
-			{ EKeys::Gamepad_DPad_Down.GetFName(), ImGuiKey_GamepadDpadDown },
-			{ EKeys::Gamepad_DPad_Right.GetFName(), ImGuiKey_GamepadDpadRight },
-			{ EKeys::Gamepad_DPad_Left.GetFName(), ImGuiKey_GamepadDpadLeft },
-
-			{ EKeys::Gamepad_LeftStick_Up.GetFName(), ImGuiKey_GamepadLStickUp },
-			{ EKeys::Gamepad_LeftStick_Down.GetFName(), ImGuiKey_GamepadLStickDown },
-			{ EKeys::Gamepad_LeftStick_Right.GetFName(), ImGuiKey_GamepadLStickRight },
-			{ EKeys::Gamepad_LeftStick_Left.GetFName(), ImGuiKey_GamepadLStickLeft },
-
-			{ EKeys::Gamepad_RightStick_Up.GetFName(), ImGuiKey_GamepadRStickUp },
-			{ EKeys::Gamepad_RightStick_Down.GetFName(), ImGuiKey_GamepadRStickDown },
-			{ EKeys::Gamepad_RightStick_Right.GetFName(), ImGuiKey_GamepadRStickRight },
-			{ EKeys::Gamepad_RightStick_Left.GetFName(), ImGuiKey_GamepadRStickLeft },
+			EKeys::Gamepad_LeftX,
+			EKeys::Gamepad_LeftY,
+			EKeys::Gamepad_RightX,
+			EKeys::Gamepad_RightY,
+			EKeys::Gamepad_LeftTriggerAxis,
+			EKeys::Gamepad_RightTriggerAxis,
 		};
+		static_assert(UE_ARRAY_COUNT(AxisKeys) == (int32)EGamepadAxis::Count);
 
-		const ImGuiKey* Key = KeyMap.Find(Keyname);
-		return Key ? *Key : ImGuiKey_None;
+		for (int32 AxisIndex = 0; AxisIndex < UE_ARRAY_COUNT(AxisKeys); ++AxisIndex)
+		{
+			if (Key == AxisKeys[AxisIndex])
+			{
+				return AxisIndex;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	// splits the axis value into the ImGui analog keys of each direction (sticks are [-1, 1], triggers [0, 1])
+	static void AddGamepadAxisEvents(ImGuiIO& IO, EGamepadAxis Axis, float Value)
+	{
+		static constexpr ImGuiKey AxisToImGuiKeys[][2] =
+		{
+			{ ImGuiKey_GamepadLStickRight, ImGuiKey_GamepadLStickLeft },
+			{ ImGuiKey_GamepadLStickUp, ImGuiKey_GamepadLStickDown },
+			{ ImGuiKey_GamepadRStickRight, ImGuiKey_GamepadRStickLeft },
+			{ ImGuiKey_GamepadRStickUp, ImGuiKey_GamepadRStickDown },
+			{ ImGuiKey_GamepadL2, ImGuiKey_None },
+			{ ImGuiKey_GamepadR2, ImGuiKey_None },
+		};
+		static_assert(UE_ARRAY_COUNT(AxisToImGuiKeys) == (int32)EGamepadAxis::Count);
+
+		constexpr float DeadZone = 0.1f;
+		const ImGuiKey* Keys = AxisToImGuiKeys[(int32)Axis];
+
+		const float PositiveValue = FMath::Max(Value, 0.f);
+		IO.AddKeyAnalogEvent(Keys[0], PositiveValue > DeadZone, PositiveValue);
+		if (Keys[1] != ImGuiKey_None)
+		{
+			const float NegativeValue = FMath::Max(-Value, 0.f);
+			IO.AddKeyAnalogEvent(Keys[1], NegativeValue > DeadZone, NegativeValue);
+		}
 	}
 
 	FORCEINLINE static EMouseCursor::Type ImGuiToUnrealCursor(ImGuiMouseCursor Cursor)
@@ -201,4 +335,107 @@ namespace ImGuiUtils
 		}
 		return MouseButton;
 	}
+
+	// high frequency mice send several moves per frame, update the trailing position event instead of queuing a new one
+	// NOTE: only merges with the last event, so moves are never reordered around clicks
+	static void AddMousePosEventCoalesced(ImGuiIO& IO, float PosX, float PosY)
+	{
+		ImGuiContext& Context = *IO.Ctx;
+		if (IO.AppAcceptingEvents && !Context.InputEventsQueue.empty())
+		{
+			ImGuiInputEvent& LastEvent = Context.InputEventsQueue.back();
+			if (LastEvent.Type == ImGuiInputEventType_MousePos && LastEvent.MousePos.MouseSource == Context.InputEventsNextMouseSource)
+			{
+				// same flooring as ImGuiIO::AddMousePosEvent
+				LastEvent.MousePos.PosX = (PosX > -FLT_MAX) ? ImFloor(PosX) : PosX;
+				LastEvent.MousePos.PosY = (PosY > -FLT_MAX) ? ImFloor(PosY) : PosY;
+				return;
+			}
+		}
+
+		IO.AddMousePosEvent(PosX, PosY);
+	}
+
+	// ImGui filters unchanged modifiers but searches the event queue once per key, resolve the latest state in a single pass instead
+	static void AddModifierKeyEvents(ImGuiIO& IO, const FModifierKeysState& ModifierKeys)
+	{
+		static constexpr ImGuiKey ModifierKeyCodes[] = { ImGuiMod_Shift, ImGuiMod_Ctrl, ImGuiMod_Alt };
+		const bool bModifiersDown[] = { ModifierKeys.IsShiftDown(), ModifierKeys.IsControlDown(), ModifierKeys.IsAltDown() };
+
+		ImGuiContext& Context = *IO.Ctx;
+		if (Context.IO.ConfigMacOSXBehaviors)
+		{
+			// key swapping is handled by ImGui
+			for (int32 ModifierIndex = 0; ModifierIndex < UE_ARRAY_COUNT(ModifierKeyCodes); ++ModifierIndex)
+			{
+				IO.AddKeyEvent(ModifierKeyCodes[ModifierIndex], bModifiersDown[ModifierIndex]);
+			}
+			return;
+		}
+
+		bool bLatestModifiersDown[UE_ARRAY_COUNT(ModifierKeyCodes)];
+		bool bResolved[UE_ARRAY_COUNT(ModifierKeyCodes)] = {};
+		int32 NumResolved = 0;
+		for (int32 EventIndex = Context.InputEventsQueue.Size - 1; EventIndex >= 0 && NumResolved < UE_ARRAY_COUNT(ModifierKeyCodes); --EventIndex)
+		{
+			const ImGuiInputEvent& Event = Context.InputEventsQueue[EventIndex];
+			if (Event.Type != ImGuiInputEventType_Key)
+			{
+				continue;
+			}
+			for (int32 ModifierIndex = 0; ModifierIndex < UE_ARRAY_COUNT(ModifierKeyCodes); ++ModifierIndex)
+			{
+				if (!bResolved[ModifierIndex] && Event.Key.Key == ModifierKeyCodes[ModifierIndex])
+				{
+					bLatestModifiersDown[ModifierIndex] = Event.Key.Down;
+					bResolved[ModifierIndex] = true;
+					++NumResolved;
+				}
+			}
+		}
+
+		for (int32 ModifierIndex = 0; ModifierIndex < UE_ARRAY_COUNT(ModifierKeyCodes); ++ModifierIndex)
+		{
+			const bool bLatestDown = bResolved[ModifierIndex] ? bLatestModifiersDown[ModifierIndex] : ImGui::GetKeyData(&Context, ModifierKeyCodes[ModifierIndex])->Down;
+			if (bLatestDown != bModifiersDown[ModifierIndex])
+			{
+				IO.AddKeyEvent(ModifierKeyCodes[ModifierIndex], bModifiersDown[ModifierIndex]);
+			}
+		}
+	}
+
+	// collapses runs of redundant events before ImGui::NewFrame trickles through the queue
+	// only adjacent events are merged (mouse positions, repeated analog values of the same key), so click/key ordering is preserved
+	static void CoalesceInputEvents(ImGuiContext* Context)
+	{
+		ImVector<ImGuiInputEvent>& InputEvents = Context->InputEventsQueue;
+
+		int32 NumEvents = 0;
+		for (int32 EventIndex = 0; EventIndex < InputEvents.Size; ++EventIndex)
+		{
+			const ImGuiInputEvent& Event = InputEvents[EventIndex];
+			if (NumEvents > 0)
+			{
+				ImGuiInputEvent& PrevEvent = InputEvents[NumEvents - 1];
+				const bool bMergeMousePos = Event.Type == ImGuiInputEventType_MousePos && PrevEvent.Type == ImGuiInputEventType_MousePos &&
+					Event.MousePos.MouseSource == PrevEvent.MousePos.MouseSource;
+				const bool bMergeAnalogKey = Event.Type == ImGuiInputEventType_Key && PrevEvent.Type == ImGuiInputEventType_Key &&
+					Event.Key.Key == PrevEvent.Key.Key && Event.Key.Down == PrevEvent.Key.Down;
+				if (bMergeMousePos || bMergeAnalogKey)
+				{
+					PrevEvent = Event;
+					continue;
+				}
+			}
+
+			if (NumEvents != EventIndex)
+			{
+				InputEvents[NumEvents] = Event;
+			}
+			++NumEvents;
+		}
+		InputEvents.resize(NumEvents);
+
+		INC_DWORD_STAT_BY(STAT_ImGui_InputEventsApplied, InputEvents.Size);
+	}
 }
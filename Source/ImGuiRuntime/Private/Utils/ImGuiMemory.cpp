@@ -0,0 +1,443 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#include "ImGuiPluginTypes.h"
+#include "ImGuiSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+
+#include <atomic>
+
+// NOTE: underscores map to the tag hierarchy (ImGui/DrawLists etc..)
+LLM_DEFINE_TAG(ImGui);
+LLM_DEFINE_TAG(ImGui_DrawLists);
+LLM_DEFINE_TAG(ImGui_FontAtlas);
+LLM_DEFINE_TAG(ImGui_ImPlot);
+LLM_DEFINE_TAG(ImGui_NetImgui);
+LLM_DEFINE_TAG(ImGui_Snapshots);
+LLM_DEFINE_TAG(ImGui_FrameArena);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Heap Allocations"), STAT_ImGui_HeapAllocations, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Frame Arena Allocations"), STAT_ImGui_FrameArenaAllocations, STATGROUP_ImGui);
+DECLARE_MEMORY_STAT(TEXT("Frame Arena High Water"), STAT_ImGui_FrameArenaHighWater, STATGROUP_ImGui);
+
+namespace ImGuiMemory
+{
+	static const char* GetCategoryName(EImGuiMemoryCategory Category)
+	{
+		switch (Category)
+		{
+		case EImGuiMemoryCategory::Core:		return "Core";
+		case EImGuiMemoryCategory::DrawLists:	return "DrawLists";
+		case EImGuiMemoryCategory::FontAtlas:	return "FontAtlas";
+		case EImGuiMemoryCategory::ImPlot:		return "ImPlot";
+		case EImGuiMemoryCategory::NetImgui:	return "NetImgui";
+		case EImGuiMemoryCategory::Snapshots:	return "Snapshots";
+		default:								return "Unknown";
+		}
+	}
+
+	// per context counters, updated lock free from any thread (frees can happen on NetImgui or render threads)
+	// NOTE: never freed, allocations can outlive their context and keep pointing to its counters
+	struct FMemoryCounters
+	{
+		std::atomic<int64> Bytes[(int32)EImGuiMemoryCategory::Count] = {};
+		std::atomic<int64> NumAllocations = 0;
+		// nullptr for the unowned bucket and for counters of destroyed contexts
+		const ImGuiContext* Context = nullptr;
+
+		int64 GetTotalBytes() const
+		{
+			int64 TotalBytes = 0;
+			for (const std::atomic<int64>& CategoryBytes : Bytes)
+			{
+				TotalBytes += CategoryBytes.load(std::memory_order_relaxed);
+			}
+			return TotalBytes;
+		}
+	};
+
+	// prepended to every allocation so frees can be attributed without a lookup
+	struct alignas(16) FAllocationHeader
+	{
+		FMemoryCounters* Counters;
+		uint32 Size;
+		EImGuiMemoryCategory Category;
+		// allocated from a frame arena, freed when the arena is recycled
+		bool bIsTransient;
+	};
+	static_assert(sizeof(FAllocationHeader) == 16, "header size must preserve allocation alignment");
+
+	class FMemoryTracker
+	{
+	public:
+		// NOTE: only allocations made on the game thread are attributed to a context, see Malloc
+		FMemoryCounters& GetCounters(const ImGuiContext* Context)
+		{
+			if (!Context)
+			{
+				return UnownedCounters;
+			}
+			if (Context == CachedContext)
+			{
+				return *CachedCounters;
+			}
+
+			check(IsInGameThread());
+			FMemoryCounters*& ContextCounters = ContextMemory.FindOrAdd(Context);
+			if (!ContextCounters)
+			{
+				ContextCounters = AllocateCounters();
+				ContextCounters->Context = Context;
+			}
+			CachedContext = Context;
+			CachedCounters = ContextCounters;
+			return *ContextCounters;
+		}
+
+		void OnAlloc(FMemoryCounters& Counters, EImGuiMemoryCategory Category, uint32 Size)
+		{
+			Counters.Bytes[(int32)Category].fetch_add(Size, std::memory_order_relaxed);
+			Counters.NumAllocations.fetch_add(1, std::memory_order_relaxed);
+
+			TotalMemory.Bytes[(int32)Category].fetch_add(Size, std::memory_order_relaxed);
+			TotalMemory.NumAllocations.fetch_add(1, std::memory_order_relaxed);
+
+			const int64 TotalBytes = TotalBytesAllocated.fetch_add(Size, std::memory_order_relaxed) + Size;
+			int64 PrevPeakBytes = PeakBytes.load(std::memory_order_relaxed);
+			while (TotalBytes > PrevPeakBytes && !PeakBytes.compare_exchange_weak(PrevPeakBytes, TotalBytes, std::memory_order_relaxed))
+			{
+			}
+		}
+
+		void OnFree(FMemoryCounters& Counters, EImGuiMemoryCategory Category, uint32 Size)
+		{
+			Counters.Bytes[(int32)Category].fetch_sub(Size, std::memory_order_relaxed);
+			Counters.NumAllocations.fetch_sub(1, std::memory_order_relaxed);
+
+			TotalMemory.Bytes[(int32)Category].fetch_sub(Size, std::memory_order_relaxed);
+			TotalMemory.NumAllocations.fetch_sub(1, std::memory_order_relaxed);
+			TotalBytesAllocated.fetch_sub(Size, std::memory_order_relaxed);
+		}
+
+		// remaining allocations of the context keep updating its counters, which are reported as unowned from now on
+		void OnContextDestroyed(const ImGuiContext* Context)
+		{
+			check(IsInGameThread());
+
+			if (Context == CachedContext)
+			{
+				CachedContext = nullptr;
+				CachedCounters = nullptr;
+			}
+
+			FMemoryCounters* ContextCounters = nullptr;
+			if (Context && ContextMemory.RemoveAndCopyValue(Context, ContextCounters))
+			{
+				ContextCounters->Context = nullptr;
+				RetiredCounters.Add(ContextCounters);
+			}
+		}
+
+		// NOTE: game thread only, reads context names
+		void Dump(FOutputDevice& Ar)
+		{
+			check(IsInGameThread());
+
+			auto LogCounters = [&Ar](const FMemoryCounters& Counters)
+				{
+					for (int32 CategoryIndex = 0; CategoryIndex < (int32)EImGuiMemoryCategory::Count; ++CategoryIndex)
+					{
+						const int64 CategoryBytes = Counters.Bytes[CategoryIndex].load(std::memory_order_relaxed);
+						if (CategoryBytes != 0)
+						{
+							Ar.Logf(TEXT("    %-10hs %10.2f KB"), GetCategoryName((EImGuiMemoryCategory)CategoryIndex), CategoryBytes / 1024.0);
+						}
+					}
+				};
+
+			Ar.Logf(TEXT("ImGui memory: %.2f KB in %lld allocations (peak %.2f KB, %llu heap allocations total)"), TotalMemory.GetTotalBytes() / 1024.0, TotalMemory.NumAllocations.load(), PeakBytes.load() / 1024.0, NumHeapAllocations.load());
+			LogCounters(TotalMemory);
+
+			for (const auto& [Context, Counters] : ContextMemory)
+			{
+				const char* ContextName = (Context->ContextName[0] != 0) ? Context->ContextName : "Unnamed";
+				Ar.Logf(TEXT("  %hs [0x%p]: %.2f KB in %lld allocations"), ContextName, Context, Counters->GetTotalBytes() / 1024.0, Counters->NumAllocations.load());
+				LogCounters(*Counters);
+			}
+
+			// destroyed contexts and allocations made off the game thread
+			FMemoryCounters Unowned;
+			for (const FMemoryCounters* Counters : RetiredCounters)
+			{
+				AddCounters(Unowned, *Counters);
+			}
+			AddCounters(Unowned, UnownedCounters);
+			Ar.Logf(TEXT("  Unowned: %.2f KB in %lld allocations"), Unowned.GetTotalBytes() / 1024.0, Unowned.NumAllocations.load());
+			LogCounters(Unowned);
+		}
+
+		std::atomic<uint64> NumHeapAllocations = 0;
+
+	private:
+		FMemoryCounters* AllocateCounters()
+		{
+			// counters of destroyed contexts can be reused once all of their allocations are gone
+			for (int32 Index = 0; Index < RetiredCounters.Num(); ++Index)
+			{
+				if (RetiredCounters[Index]->NumAllocations.load() == 0)
+				{
+					FMemoryCounters* Counters = RetiredCounters[Index];
+					RetiredCounters.RemoveAtSwap(Index);
+					for (std::atomic<int64>& CategoryBytes : Counters->Bytes)
+					{
+						CategoryBytes.store(0, std::memory_order_relaxed);
+					}
+					return Counters;
+				}
+			}
+			return new FMemoryCounters();
+		}
+
+		static void AddCounters(FMemoryCounters& Dest, const FMemoryCounters& Src)
+		{
+			for (int32 CategoryIndex = 0; CategoryIndex < (int32)EImGuiMemoryCategory::Count; ++CategoryIndex)
+			{
+				Dest.Bytes[CategoryIndex] += Src.Bytes[CategoryIndex].load(std::memory_order_relaxed);
+			}
+			Dest.NumAllocations += Src.NumAllocations.load(std::memory_order_relaxed);
+		}
+
+		// NOTE: game thread only (context creation/destruction and Dump), the alloc/free path doesn't touch them
+		TMap<const ImGuiContext*, FMemoryCounters*> ContextMemory;
+		TArray<FMemoryCounters*> RetiredCounters;
+		const ImGuiContext* CachedContext = nullptr;
+		FMemoryCounters* CachedCounters = nullptr;
+
+		FMemoryCounters UnownedCounters;
+		FMemoryCounters TotalMemory;
+		std::atomic<int64> TotalBytesAllocated = 0;
+		std::atomic<int64> PeakBytes = 0;
+	};
+
+	// NOTE: intentionally leaked, ImGui memory is freed by statics of other modules/translation units during exit
+	static FMemoryTracker& GetMemoryTracker()
+	{
+		static FMemoryTracker* MemoryTracker = new FMemoryTracker();
+		return *MemoryTracker;
+	}
+
+	// bump allocator for transient allocations, blocks are kept around so steady state frames don't touch the heap
+	class FFrameArena
+	{
+	public:
+		static constexpr SIZE_T BlockSize = 64 * 1024;
+
+		~FFrameArena()
+		{
+			for (void* Block : Blocks)
+			{
+				FMemory::Free(Block);
+			}
+		}
+
+		// returns nullptr for allocations that don't fit a block, caller falls back to the heap
+		void* Allocate(SIZE_T Size)
+		{
+			Size = Align(Size, 16);
+			if (Size > BlockSize)
+			{
+				return nullptr;
+			}
+
+			if (Blocks.IsEmpty() || (BlockOffset + Size > BlockSize))
+			{
+				if (!Blocks.IsEmpty())
+				{
+					BlockIndex++;
+				}
+				if (BlockIndex >= Blocks.Num())
+				{
+					LLM_SCOPE_BYTAG(ImGui_FrameArena);
+					Blocks.Add(FMemory::Malloc(BlockSize, 16));
+				}
+				BlockOffset = 0;
+			}
+
+			void* Allocation = (uint8*)Blocks[BlockIndex] + BlockOffset;
+			BlockOffset += Size;
+			UsedBytes += Size;
+			NumAllocations++;
+			return Allocation;
+		}
+
+		void Reset()
+		{
+#if !UE_BUILD_SHIPPING
+			// transient pointers kept past the end of their frame read garbage instead of stale data
+			for (int32 Index = 0; Index < Blocks.Num() && Index <= BlockIndex; ++Index)
+			{
+				FMemory::Memset(Blocks[Index], 0xDD, (Index == BlockIndex) ? BlockOffset : BlockSize);
+			}
+#endif
+
+			HighWaterMark = FMath::Max(HighWaterMark, UsedBytes);
+			BlockIndex = 0;
+			BlockOffset = 0;
+			UsedBytes = 0;
+			NumAllocations = 0;
+		}
+
+		TArray<void*> Blocks;
+		int32 BlockIndex = 0;
+		SIZE_T BlockOffset = 0;
+		SIZE_T UsedBytes = 0;
+		SIZE_T HighWaterMark = 0;
+		int32 NumAllocations = 0;
+	};
+
+	// NOTE: arenas are only used on the game thread, leaked for the same reason as the memory tracker
+	static TMap<const ImGuiContext*, TUniquePtr<FFrameArena>>& GetFrameArenas()
+	{
+		static TMap<const ImGuiContext*, TUniquePtr<FFrameArena>>* FrameArenas = new TMap<const ImGuiContext*, TUniquePtr<FFrameArena>>();
+		return *FrameArenas;
+	}
+
+	static FFrameArena& GetFrameArena(const ImGuiContext* Context)
+	{
+		TUniquePtr<FFrameArena>& FrameArena = GetFrameArenas().FindOrAdd(Context);
+		if (!FrameArena)
+		{
+			FrameArena = MakeUnique<FFrameArena>();
+		}
+		return *FrameArena;
+	}
+
+	static void DumpFrameArenas(FOutputDevice& Ar)
+	{
+		for (const auto& [Context, FrameArena] : GetFrameArenas())
+		{
+			const char* ContextName = (Context->ContextName[0] != 0) ? Context->ContextName : "Unnamed";
+			Ar.Logf(TEXT("  %hs [0x%p] frame arena: %d blocks, high water %.2f KB"), ContextName, Context, FrameArena->Blocks.Num(), FrameArena->HighWaterMark / 1024.0);
+		}
+	}
+
+	static thread_local EImGuiMemoryCategory CurrentCategory = EImGuiMemoryCategory::Core;
+	static thread_local bool bTransientAllocations = false;
+
+	static void* MallocTagged(size_t Size, EImGuiMemoryCategory Category)
+	{
+		switch (Category)
+		{
+		case EImGuiMemoryCategory::DrawLists:	{ LLM_SCOPE_BYTAG(ImGui_DrawLists);	return FMemory::Malloc(Size); }
+		case EImGuiMemoryCategory::FontAtlas:	{ LLM_SCOPE_BYTAG(ImGui_FontAtlas);	return FMemory::Malloc(Size); }
+		case EImGuiMemoryCategory::ImPlot:		{ LLM_SCOPE_BYTAG(ImGui_ImPlot);	return FMemory::Malloc(Size); }
+		case EImGuiMemoryCategory::NetImgui:	{ LLM_SCOPE_BYTAG(ImGui_NetImgui);	return FMemory::Malloc(Size); }
+		case EImGuiMemoryCategory::Snapshots:	{ LLM_SCOPE_BYTAG(ImGui_Snapshots);	return FMemory::Malloc(Size); }
+		default:								{ LLM_SCOPE_BYTAG(ImGui);			return FMemory::Malloc(Size); }
+		}
+	}
+
+	void* Malloc(size_t Size, void* UserData)
+	{
+		EImGuiMemoryCategory Category = CurrentCategory;
+		const ImGuiContext* Context = nullptr;
+		if (IsInGameThread())
+		{
+			Context = UserData ? *(ImGuiContext**)UserData : nullptr;
+		}
+
+		if (bTransientAllocations && Context)
+		{
+			if (FAllocationHeader* Header = (FAllocationHeader*)GetFrameArena(Context).Allocate(Size + sizeof(FAllocationHeader)))
+			{
+				INC_DWORD_STAT(STAT_ImGui_FrameArenaAllocations);
+
+				Header->Counters = nullptr;
+				Header->Size = (uint32)Size;
+				Header->Category = Category;
+				Header->bIsTransient = true;
+				return Header + 1;
+			}
+		}
+
+		FMemoryTracker& MemoryTracker = GetMemoryTracker();
+		FAllocationHeader* Header = (FAllocationHeader*)MallocTagged(Size + sizeof(FAllocationHeader), Category);
+		Header->Counters = &MemoryTracker.GetCounters(Context);
+		Header->Size = (uint32)Size;
+		Header->Category = Category;
+		Header->bIsTransient = false;
+
+		INC_DWORD_STAT(STAT_ImGui_HeapAllocations);
+		MemoryTracker.NumHeapAllocations.fetch_add(1, std::memory_order_relaxed);
+		MemoryTracker.OnAlloc(*Header->Counters, Category, Header->Size);
+		return Header + 1;
+	}
+
+	void Free(void* Pointer, void* UserData)
+	{
+		if (!Pointer)
+		{
+			return;
+		}
+
+		FAllocationHeader* Header = (FAllocationHeader*)Pointer - 1;
+		if (Header->bIsTransient)
+		{
+			// released in bulk when the arena is recycled
+			return;
+		}
+
+		GetMemoryTracker().OnFree(*Header->Counters, Header->Category, Header->Size);
+		FMemory::Free(Header);
+	}
+
+	EImGuiMemoryCategory SetCurrentCategory(EImGuiMemoryCategory Category)
+	{
+		const EImGuiMemoryCategory PrevCategory = CurrentCategory;
+		CurrentCategory = Category;
+		return PrevCategory;
+	}
+
+	void OnContextDestroyed(const ImGuiContext* Context)
+	{
+		GetMemoryTracker().OnContextDestroyed(Context);
+		GetFrameArenas().Remove(Context);
+	}
+
+	bool SetTransientAllocations(bool bEnable)
+	{
+		const bool bPrevState = bTransientAllocations;
+		bTransientAllocations = bEnable && IsInGameThread();
+		return bPrevState;
+	}
+
+	void ResetFrameArena(const ImGuiContext* Context)
+	{
+		TMap<const ImGuiContext*, TUniquePtr<FFrameArena>>& FrameArenas = GetFrameArenas();
+		if (TUniquePtr<FFrameArena>* FrameArena = FrameArenas.Find(Context))
+		{
+			(*FrameArena)->Reset();
+
+			SIZE_T HighWaterMark = 0;
+			for (const auto& [ArenaContext, Arena] : FrameArenas)
+			{
+				HighWaterMark = FMath::Max(HighWaterMark, Arena->HighWaterMark);
+			}
+			SET_MEMORY_STAT(STAT_ImGui_FrameArenaHighWater, HighWaterMark);
+		}
+	}
+
+	uint64 GetHeapAllocationCount()
+	{
+		return GetMemoryTracker().NumHeapAllocations.load();
+	}
+
+	static FAutoConsoleCommandWithOutputDevice CmdDumpMemory(
+		TEXT("imgui.Memory.Dump"),
+		TEXT("Dumps ImGui memory usage per context and per category."),
+		FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+			{
+				GetMemoryTracker().Dump(Ar);
+				DumpFrameArenas(Ar);
+			}));
+}
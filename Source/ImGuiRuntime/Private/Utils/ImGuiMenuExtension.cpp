@@ -13,6 +13,7 @@
 #include "Misc/ConfigCacheIni.h"
 #include "Engine/GameViewportClient.h"
 #include "Framework/Commands/InputChord.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "Framework/Application/SlateUser.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Framework/Application/IInputProcessor.h"
@@ -62,6 +63,17 @@ static TAutoConsoleVariable<bool> CVarAutoHideMainMenuBar(
 	true,
 	TEXT("Auto hide ImGui main menu bar"));
 
+static TAutoConsoleVariable<float> CVarMainMenuFrameBudget(
+	TEXT("imgui.FrameBudget.MainMenuMs"),
+	8.f,
+	TEXT("Time budget (in ms) shared by all active main menu widgets, split b/w widgets that are yet to tick (0 for no limit).\n")
+	TEXT("Widgets get less time for time sliced work once the budget is used up."));
+
+static TAutoConsoleVariable<bool> CVarShowWidgetTickCost(
+	TEXT("imgui.MainMenu.ShowWidgetCost"),
+	false,
+	TEXT("Show total tick cost of main menu widgets in the menu bar, click the readout for a per widget breakdown."));
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #define LOCTEXT_NAMESPACE "ImGuiPlugin"
@@ -230,6 +242,48 @@ namespace ImGuiUtils
 			// is the menu item active and drawing the widget window
 			bool bIsActive = false;
 			EImGuiMainMenuWidgetFlags WidgetFlags = EImGuiMainMenuWidgetFlags::None;
+			// number of ticks that took longer than the widget's frame budget
+			int32 BudgetOverrunCount = 0;
+			float LastBudgetOverrunMs = 0.f;
+
+			// tick cost tracking, surfaced through `imgui.MainMenu.ShowWidgetCost` and stat/trace scopes named after the widget path
+			void RecordTickTime(float TickMs)
+			{
+				LastTickMs = TickMs;
+				AverageTickMs = (NumTicks == 0) ? TickMs : FMath::Lerp(AverageTickMs, TickMs, 0.05f);
+				PeakTickMs = FMath::Max(PeakTickMs, TickMs);
+				NumTicks++;
+			}
+			void ResetTickTime()
+			{
+				LastTickMs = AverageTickMs = PeakTickMs = 0.f;
+				NumTicks = 0;
+			}
+#if STATS
+			TStatId GetStatId()
+			{
+				if (!StatId.IsValidStat())
+				{
+					StatId = FDynamicStats::CreateStatId<FStatGroup_STATGROUP_ImGui>(FString(UTF8_TO_TCHAR(*Path)));
+				}
+				return StatId;
+			}
+			TStatId StatId;
+#else
+			const TCHAR* GetTraceName()
+			{
+				if (TraceName.IsEmpty())
+				{
+					TraceName = UTF8_TO_TCHAR(*Path);
+				}
+				return *TraceName;
+			}
+			FString TraceName;
+#endif
+			float LastTickMs = 0.f;
+			float AverageTickMs = 0.f;
+			float PeakTickMs = 0.f;
+			int32 NumTicks = 0;
 		};
 
 		struct FQueuedWidgetSlot
@@ -706,6 +760,13 @@ namespace ImGuiUtils
 		UImGuiSubsystem* m_ImGuiSubsystem = nullptr;
 		FImGuiImageBindingParams m_ExpandedMenuIcon{};
 		FImGuiImageBindingParams m_CollapsedMenuIcon{};
+		// global frame budget left for the widgets that are yet to tick
+		double m_FrameBudgetRemaining = 0.0;
+		int32 m_NumWidgetsLeftToTick = 0;
+		// tick cost of all main menu widgets
+		float m_WidgetTickMs = 0.f;
+		float m_LastFrameWidgetTickMs = 0.f;
+		bool m_bShowWidgetCostTable = false;
 
 		void TickMainMenuBar(FImGuiMenuContainer& MenuContainer, FImGuiMenuContainer::FWidgetSlot& Slot, FImGuiTickContext* TickContext)
 		{
@@ -726,7 +787,11 @@ namespace ImGuiUtils
 					{
 						Slot.bIsActive = !Slot.bIsActive;
 					}
-					if (Slot.ToolTip.Len() > 0)
+					if (Slot.BudgetOverrunCount > 0)
+					{
+						ImGui::SetItemTooltip("%s%sOver frame budget %d times (last %.2f ms)", *Slot.ToolTip, (Slot.ToolTip.Len() > 0) ? "\n" : "", Slot.BudgetOverrunCount, Slot.LastBudgetOverrunMs);
+					}
+					else if (Slot.ToolTip.Len() > 0)
 					{
 						ImGui::SetItemTooltip("%s", *Slot.ToolTip);
 					}
@@ -749,6 +814,58 @@ namespace ImGuiUtils
 					}, m_ExpandedMenuIcon, m_CollapsedMenuIcon);
 			}
 		}
+		static int32 CountActiveWidgets(const FImGuiMenuContainer::FWidgetSlot& Slot)
+		{
+			if (Slot.IsMenuItem())
+			{
+				return Slot.bIsActive ? 1 : 0;
+			}
+
+			int32 NumActiveWidgets = 0;
+			for (const auto& Child : Slot.GetChildren())
+			{
+				NumActiveWidgets += CountActiveWidgets(Child);
+			}
+			return NumActiveWidgets;
+		}
+
+		void TickWidgetWithBudget(FImGuiMenuContainer::FWidgetSlot& Slot, FImGuiTickContext* TickContext)
+		{
+			// fair share of the remaining global budget, capped by the per widget budget
+			const double MaxWidgetBudget = GetWidgetFrameBudgetSeconds();
+			const double WidgetBudget = FMath::Min(MaxWidgetBudget, m_FrameBudgetRemaining / FMath::Max(1, m_NumWidgetsLeftToTick));
+
+			TickContext->BeginFrameBudget(WidgetBudget);
+			{
+#if STATS
+				FScopeCycleCounter CycleCounter(Slot.GetStatId());
+#else
+				TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(Slot.GetTraceName());
+#endif
+				Slot.GetTickDelegate().ExecuteIfBound(TickContext);
+			}
+			const double TickTime = TickContext->EndFrameBudget();
+
+			Slot.RecordTickTime((float)(TickTime * 1000.0));
+			m_WidgetTickMs += (float)(TickTime * 1000.0);
+
+			m_FrameBudgetRemaining = FMath::Max(0.0, m_FrameBudgetRemaining - TickTime);
+			SkipWidgetBudget();
+
+			// NOTE: only the per widget cap counts, the shared budget can be used up by the widgets ticked before this one
+			if (TickTime > MaxWidgetBudget)
+			{
+				Slot.BudgetOverrunCount++;
+				Slot.LastBudgetOverrunMs = (float)(TickTime * 1000.0);
+			}
+		}
+
+		// active widgets that don't tick this frame (collapsed windows) leave their share to the remaining ones
+		void SkipWidgetBudget()
+		{
+			m_NumWidgetsLeftToTick = FMath::Max(0, m_NumWidgetsLeftToTick - 1);
+		}
+
 		void TickMainMenuWidgets(FImGuiMenuContainer& MenuContainer, FImGuiMenuContainer::FWidgetSlot& Slot, FImGuiTickContext* TickContext)
 		{
 			if (Slot.IsMenuItem())
@@ -757,7 +874,7 @@ namespace ImGuiUtils
 				{
 					if (EnumHasAnyFlags(Slot.WidgetFlags, EImGuiMainMenuWidgetFlags::SkipWindowCreation))
 					{
-						Slot.GetTickDelegate().ExecuteIfBound(TickContext);
+						TickWidgetWithBudget(Slot, TickContext);
 					}
 					else
 					{
@@ -765,7 +882,11 @@ namespace ImGuiUtils
 						ImGui::SetNextWindowSize(ImVec2(512.f, 512.f), ImGuiCond_FirstUseEver);
 						if (ImGui::Begin(Slot.GetName(), &Slot.bIsActive))
 						{
-							Slot.GetTickDelegate().ExecuteIfBound(TickContext);
+							TickWidgetWithBudget(Slot, TickContext);
+						}
+						else
+						{
+							SkipWidgetBudget();
 						}
 						ImGui::End();
 
@@ -785,6 +906,97 @@ namespace ImGuiUtils
 			}
 		}
 
+		static void GatherTickedWidgets(FImGuiMenuContainer::FWidgetSlot& Slot, TArray<FImGuiMenuContainer::FWidgetSlot*>& OutSlots)
+		{
+			if (Slot.IsMenuItem())
+			{
+				if (Slot.NumTicks > 0)
+				{
+					OutSlots.Add(&Slot);
+				}
+			}
+			else
+			{
+				for (auto& Child : Slot.GetChildren())
+				{
+					GatherTickedWidgets(Child, OutSlots);
+				}
+			}
+		}
+
+		void TickWidgetCostTable(TArray<FImGuiMenuContainer::FWidgetSlot>& Slots)
+		{
+			ImGui::SetNextWindowSize(ImVec2(512.f, 256.f), ImGuiCond_FirstUseEver);
+			if (ImGui::Begin("Widget Tick Cost", &m_bShowWidgetCostTable))
+			{
+				TArray<FImGuiMenuContainer::FWidgetSlot*> TickedSlots;
+				for (FImGuiMenuContainer::FWidgetSlot& Slot : Slots)
+				{
+					GatherTickedWidgets(Slot, TickedSlots);
+				}
+
+				if (ImGui::Button("Reset"))
+				{
+					for (FImGuiMenuContainer::FWidgetSlot* Slot : TickedSlots)
+					{
+						Slot->ResetTickTime();
+						Slot->BudgetOverrunCount = 0;
+					}
+					TickedSlots.Reset();
+				}
+
+				const ImGuiTableFlags TableFlags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+				if (ImGui::BeginTable("WidgetTickCost", 5, TableFlags))
+				{
+					ImGui::TableSetupScrollFreeze(0, 1);
+					ImGui::TableSetupColumn("Widget", ImGuiTableColumnFlags_WidthStretch);
+					ImGui::TableSetupColumn("Avg (ms)", ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+					ImGui::TableSetupColumn("Last (ms)", ImGuiTableColumnFlags_PreferSortDescending);
+					ImGui::TableSetupColumn("Peak (ms)", ImGuiTableColumnFlags_PreferSortDescending);
+					ImGui::TableSetupColumn("Overruns", ImGuiTableColumnFlags_PreferSortDescending);
+					ImGui::TableHeadersRow();
+
+					if (ImGuiTableSortSpecs* SortSpecs = ImGui::TableGetSortSpecs(); SortSpecs && SortSpecs->SpecsCount > 0)
+					{
+						const ImGuiTableColumnSortSpecs& Spec = SortSpecs->Specs[0];
+						auto GetSortKey = [Column = Spec.ColumnIndex](const FImGuiMenuContainer::FWidgetSlot& Slot) -> float
+							{
+								switch (Column)
+								{
+								case 1: return Slot.AverageTickMs;
+								case 2: return Slot.LastTickMs;
+								case 3: return Slot.PeakTickMs;
+								case 4: return (float)Slot.BudgetOverrunCount;
+								default: return 0.f;
+								}
+							};
+
+						const bool bAscending = (Spec.SortDirection == ImGuiSortDirection_Ascending);
+						TickedSlots.Sort([&](const FImGuiMenuContainer::FWidgetSlot& A, const FImGuiMenuContainer::FWidgetSlot& B)
+							{
+								if (Spec.ColumnIndex == 0)
+								{
+									return bAscending ? (A < B) : (B < A);
+								}
+								return bAscending ? (GetSortKey(A) < GetSortKey(B)) : (GetSortKey(B) < GetSortKey(A));
+							});
+					}
+
+					for (const FImGuiMenuContainer::FWidgetSlot* Slot : TickedSlots)
+					{
+						ImGui::TableNextRow();
+						ImGui::TableNextColumn(); ImGui::TextUnformatted(*Slot->Path);
+						ImGui::TableNextColumn(); ImGui::Text("%.3f", Slot->AverageTickMs);
+						ImGui::TableNextColumn(); ImGui::Text("%.3f", Slot->LastTickMs);
+						ImGui::TableNextColumn(); ImGui::Text("%.3f", Slot->PeakTickMs);
+						ImGui::TableNextColumn(); ImGui::Text("%d", Slot->BudgetOverrunCount);
+					}
+					ImGui::EndTable();
+				}
+			}
+			ImGui::End();
+		}
+
 		static bool HasAnyDockedWindow(ImGuiDockNode* Node)
 		{
 			if (!Node) return false;
@@ -859,6 +1071,21 @@ namespace ImGuiUtils
 							ImGui::MenuItem("Search");
 						}
 
+						if (CVarShowWidgetTickCost.GetValueOnGameThread())
+						{
+							// cost of the previous frame, widgets tick after the menu bar
+							char CostLabel[64];
+							FCStringAnsi::Snprintf(CostLabel, sizeof(CostLabel), "%.2f ms###WidgetTickCost", m_LastFrameWidgetTickMs);
+							if (TickContext->AllocateSpaceForRightAlignedMenuItem(CostLabel))
+							{
+								if (ImGui::MenuItem(CostLabel, nullptr, m_bShowWidgetCostTable))
+								{
+									m_bShowWidgetCostTable = !m_bShowWidgetCostTable;
+								}
+								ImGui::SetItemTooltip("Time spent ticking main menu widgets, click for a per widget breakdown");
+							}
+						}
+
 						for (FImGuiMenuContainer::FWidgetSlot& Slot : Slots)
 						{
 							if (!Slot.IsRightAligned())
@@ -1045,10 +1272,25 @@ namespace ImGuiUtils
 				}
 			}
 
+			const float MainMenuBudgetMs = CVarMainMenuFrameBudget.GetValueOnGameThread();
+			m_FrameBudgetRemaining = (MainMenuBudgetMs > 0.f) ? (MainMenuBudgetMs / 1000.0) : TNumericLimits<double>::Max();
+			m_NumWidgetsLeftToTick = 0;
+			for (const FImGuiMenuContainer::FWidgetSlot& Slot : Slots)
+			{
+				m_NumWidgetsLeftToTick += CountActiveWidgets(Slot);
+			}
+
+			m_WidgetTickMs = 0.f;
 			for (FImGuiMenuContainer::FWidgetSlot& Slot : Slots)
 			{
 				TickMainMenuWidgets(MenuContainer, Slot, TickContext);
 			}
+			m_LastFrameWidgetTickMs = m_WidgetTickMs;
+
+			if (m_bShowWidgetCostTable)
+			{
+				TickWidgetCostTable(Slots);
+			}
 
 			// we are done with the dock node
 			// if we enter `TickImGuiInternal` again that would mean the event is coming from window resizing
@@ -1103,6 +1345,11 @@ namespace ImGuiUtils
 				FConsoleCommandWithWorldDelegate::CreateRaw(this, &FImGuiMenuExtension::TogglePrimaryImGuiContext));
 #endif
 
+			m_ReportFrameBudgetCommand = MakeUnique<FAutoConsoleCommandWithOutputDevice>(
+				TEXT("imgui.FrameBudget.Report"),
+				TEXT("Lists main menu widgets that went over their frame budget."),
+				FConsoleCommandWithOutputDeviceDelegate::CreateRaw(this, &FImGuiMenuExtension::ReportFrameBudgetOverruns));
+
 			FString RawChordString;
 			if (GConfig && GConfig->GetString(TEXT("ImGuiPlugin"), TEXT("ToggleMenuKeyChord"), RawChordString, GInputIni))
 			{
@@ -1141,6 +1388,44 @@ namespace ImGuiUtils
 			m_PrimaryContextWidget.Reset();
 
 			m_OpenImGuiMenuCommand.Reset();
+			m_ReportFrameBudgetCommand.Reset();
+		}
+
+		static void ReportFrameBudgetOverruns(const FImGuiMenuContainer::FWidgetSlot& Slot, FOutputDevice& Ar)
+		{
+			if (Slot.IsMenuItem())
+			{
+				if (Slot.BudgetOverrunCount > 0)
+				{
+					Ar.Logf(TEXT("  %s: %d overruns (last %.2f ms)"), ANSI_TO_TCHAR(*Slot.Path), Slot.BudgetOverrunCount, Slot.LastBudgetOverrunMs);
+				}
+			}
+			else
+			{
+				for (const auto& Child : Slot.GetChildren())
+				{
+					ReportFrameBudgetOverruns(Child, Ar);
+				}
+			}
+		}
+		void ReportFrameBudgetOverruns(FOutputDevice& Ar)
+		{
+			auto ReportMenuContainer = [&Ar](const TCHAR* ContainerName, const FImGuiMenuContainer& MenuContainer)
+				{
+					Ar.Logf(TEXT("%s:"), ContainerName);
+					for (const FImGuiMenuContainer::FWidgetSlot& Slot : MenuContainer.WidgetSlots)
+					{
+						ReportFrameBudgetOverruns(Slot, Ar);
+					}
+				};
+
+			ReportMenuContainer(TEXT("Primary"), m_PrimaryContextMenuContainer);
+#if WITH_EDITOR
+			for (int32 ContainerIndex = 0; ContainerIndex < m_PIEMenuContainers.Num(); ++ContainerIndex)
+			{
+				ReportMenuContainer(*FString::Printf(TEXT("PIE %d"), ContainerIndex), m_PIEMenuContainers[ContainerIndex]);
+			}
+#endif
 		}
 
 		virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override
@@ -1472,6 +1757,7 @@ namespace ImGuiUtils
 		TSharedPtr<SImGuiMainMenuWidget> m_PinnedPrimaryContextWidget;
 
 		TUniquePtr<FAutoConsoleCommandWithWorld> m_OpenImGuiMenuCommand = nullptr;
+		TUniquePtr<FAutoConsoleCommandWithOutputDevice> m_ReportFrameBudgetCommand = nullptr;
 
 		FInputChord m_ToggleMenuKeyChord;
 		FInputChord m_SetUIFocusKeyChord;
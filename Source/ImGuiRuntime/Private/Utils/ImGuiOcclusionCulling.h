@@ -0,0 +1,259 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#pragma once
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Draw Lists"), STAT_ImGui_CulledDrawLists, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Vertices"), STAT_ImGui_CulledVertices, STATGROUP_ImGui);
+
+namespace ImGuiUtils
+{
+	// finds the draw lists of a viewport hidden behind opaque window backgrounds drawn later in the frame
+	// occluders are conservative (background rect minus rounding/title bar, only fully opaque backgrounds), draw lists are bound by their clip rects
+	// NOTE: game thread only, reads the window state of the current context so it has to run before the draw data is snapshotted
+	class FImGuiOcclusionCulling : FNoncopyable
+	{
+	public:
+		// returns the number of culled draw lists, see IsCulled
+		int32 Build(const ImDrawData* DrawData)
+		{
+			CulledLists.Reset();
+			Occluders.Reset();
+			ListIndices.Reset();
+
+			const ImGuiContext* Context = ImGui::GetCurrentContext();
+			if (!Context || DrawData->CmdListsCount < 2)
+			{
+				return 0;
+			}
+
+			for (ImGuiWindow* Window : Context->Windows)
+			{
+				if (Window->Viewport == DrawData->OwnerViewport)
+				{
+					AddOccluder(DrawData, Window);
+				}
+			}
+			// NOTE: the default (dark) style has translucent window backgrounds, nothing past this point runs unless a style/window makes them opaque
+			if (Occluders.IsEmpty())
+			{
+				return 0;
+			}
+
+			// front to back, lists only need to be tested against the occluders drawn after them
+			Occluders.Sort([](const FOccluder& A, const FOccluder& B) { return A.ListIndex > B.ListIndex; });
+
+			int32 NumCulled = 0;
+			int32 NumCulledVertices = 0;
+			CulledLists.Init(false, DrawData->CmdListsCount);
+			for (int32 ListIndex = 0; ListIndex < DrawData->CmdListsCount; ++ListIndex)
+			{
+				const ImDrawList* DrawList = DrawData->CmdLists[ListIndex];
+				if (IsOccluded(DrawList, ListIndex))
+				{
+					CulledLists[ListIndex] = true;
+					NumCulledVertices += DrawList->VtxBuffer.Size;
+					++NumCulled;
+				}
+			}
+
+			INC_DWORD_STAT_BY(STAT_ImGui_CulledDrawLists, NumCulled);
+			INC_DWORD_STAT_BY(STAT_ImGui_CulledVertices, NumCulledVertices);
+			return NumCulled;
+		}
+
+		bool IsCulled(int32 ListIndex) const
+		{
+			return CulledLists.IsValidIndex(ListIndex) && CulledLists[ListIndex];
+		}
+
+		// removes the culled lists from a draw data with the same lists (i.e. its snapshot)
+		void RemoveCulled(ImDrawData* DrawData) const
+		{
+			if (CulledLists.Num() != DrawData->CmdListsCount)
+			{
+				return;
+			}
+
+			int32 NumKept = 0;
+			for (int32 ListIndex = 0; ListIndex < DrawData->CmdListsCount; ++ListIndex)
+			{
+				ImDrawList* DrawList = DrawData->CmdLists[ListIndex];
+				if (CulledLists[ListIndex])
+				{
+					DrawData->TotalVtxCount -= DrawList->VtxBuffer.Size;
+					DrawData->TotalIdxCount -= DrawList->IdxBuffer.Size;
+				}
+				else
+				{
+					DrawData->CmdLists[NumKept++] = DrawList;
+				}
+			}
+			DrawData->CmdLists.resize(NumKept);
+			DrawData->CmdListsCount = NumKept;
+		}
+
+	private:
+		struct FOccluder
+		{
+			ImRect Rect;
+			// draw list the window background is drawn into, covers the lists drawn before it
+			int32 ListIndex = INDEX_NONE;
+		};
+
+		// window backgrounds only (title bars, borders etc.. are ignored)
+		void AddOccluder(const ImDrawData* DrawData, const ImGuiWindow* Window)
+		{
+			if (!Window->Active || Window->Hidden || Window->Collapsed || (Window->Flags & (ImGuiWindowFlags_NoBackground | ImGuiWindowFlags_DockNodeHost)))
+			{
+				return;
+			}
+
+			const ImDrawList* BgDrawList = nullptr;
+			if (Window->DockIsActive)
+			{
+				// docked window backgrounds are drawn by the host window with the color they were submitted with
+				if (!Window->DockTabIsVisible || !Window->DockNode || !Window->DockNode->HostWindow || !IsOpaque(Window->DockNode->LastBgColor))
+				{
+					return;
+				}
+				BgDrawList = Window->DockNode->HostWindow->DrawList;
+			}
+			else
+			{
+				if (Window->Flags & ImGuiWindowFlags_ChildWindow)
+				{
+					return;
+				}
+
+				// background is the first thing drawn into the window's list, also catches SetNextWindowBgAlpha
+				const ImGuiCol BgColorIndex = ((Window->Flags & ImGuiWindowFlags_Popup) || (Window->Flags & ImGuiWindowFlags_Tooltip)) ? ImGuiCol_PopupBg : ImGuiCol_WindowBg;
+				if (!Window->ViewportOwned && !IsOpaque(ImGui::GetColorU32(BgColorIndex)))
+				{
+					return;
+				}
+				if (Window->DrawList->VtxBuffer.Size == 0 || !IsOpaque(Window->DrawList->VtxBuffer[0].col))
+				{
+					return;
+				}
+				BgDrawList = Window->DrawList;
+			}
+
+			const int32* ListIndex = FindListIndex(DrawData, BgDrawList);
+			if (!ListIndex)
+			{
+				return;
+			}
+
+			const float Rounding = Window->WindowRounding;
+			ImRect Rect(Window->Pos + ImVec2(0.f, Window->TitleBarHeight), Window->Pos + Window->Size);
+			Rect.Expand(-Rounding);
+			if (Rect.GetWidth() > 0.f && Rect.GetHeight() > 0.f)
+			{
+				Occluders.Add({ Rect, *ListIndex });
+			}
+		}
+
+		// lookup is only built once a window has an opaque background
+		const int32* FindListIndex(const ImDrawData* DrawData, const ImDrawList* DrawList)
+		{
+			if (ListIndices.IsEmpty())
+			{
+				for (int32 ListIndex = 0; ListIndex < DrawData->CmdListsCount; ++ListIndex)
+				{
+					ListIndices.Add(DrawData->CmdLists[ListIndex], ListIndex);
+				}
+			}
+			return ListIndices.Find(DrawList);
+		}
+
+		bool IsOccluded(const ImDrawList* DrawList, int32 ListIndex)
+		{
+			// draw lists are bound by the clip rects of their commands, callbacks can change state for the following lists so they are kept
+			ImRect Bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+			for (const ImDrawCmd& DrawCmd : DrawList->CmdBuffer)
+			{
+				if (DrawCmd.UserCallback)
+				{
+					return false;
+				}
+				if (DrawCmd.ElemCount > 0)
+				{
+					Bounds.Add(ImRect(DrawCmd.ClipRect));
+				}
+			}
+			if (Bounds.Min.x >= Bounds.Max.x || Bounds.Min.y >= Bounds.Max.y)
+			{
+				return false;
+			}
+
+			// subtract the occluders from the bounds until nothing is left (stacked windows rarely leave more than a few pieces)
+			VisibleRects.Reset();
+			VisibleRects.Add(Bounds);
+			for (const FOccluder& Occluder : Occluders)
+			{
+				if (Occluder.ListIndex <= ListIndex)
+				{
+					break;
+				}
+
+				const int32 NumRects = VisibleRects.Num();
+				for (int32 RectIndex = 0; RectIndex < NumRects; ++RectIndex)
+				{
+					SubtractRect(VisibleRects[RectIndex], Occluder.Rect, VisibleRects);
+				}
+				VisibleRects.RemoveAt(0, NumRects, EAllowShrinking::No);
+
+				if (VisibleRects.IsEmpty())
+				{
+					return true;
+				}
+				if (VisibleRects.Num() > MaxVisibleRects)
+				{
+					return false;
+				}
+			}
+			return false;
+		}
+
+		// appends the parts of `Rect` outside of `Occluder` (up to 4 rects)
+		static void SubtractRect(ImRect Rect, const ImRect& Occluder, TArray<ImRect, TInlineAllocator<16>>& OutRects)
+		{
+			if (!Rect.Overlaps(Occluder))
+			{
+				OutRects.Add(Rect);
+				return;
+			}
+
+			if (Rect.Min.y < Occluder.Min.y)
+			{
+				OutRects.Add(ImRect(Rect.Min.x, Rect.Min.y, Rect.Max.x, Occluder.Min.y));
+				Rect.Min.y = Occluder.Min.y;
+			}
+			if (Rect.Max.y > Occluder.Max.y)
+			{
+				OutRects.Add(ImRect(Rect.Min.x, Occluder.Max.y, Rect.Max.x, Rect.Max.y));
+				Rect.Max.y = Occluder.Max.y;
+			}
+			if (Rect.Min.x < Occluder.Min.x)
+			{
+				OutRects.Add(ImRect(Rect.Min.x, Rect.Min.y, Occluder.Min.x, Rect.Max.y));
+			}
+			if (Rect.Max.x > Occluder.Max.x)
+			{
+				OutRects.Add(ImRect(Occluder.Max.x, Rect.Min.y, Rect.Max.x, Rect.Max.y));
+			}
+		}
+
+		static bool IsOpaque(ImU32 Color)
+		{
+			return (Color & IM_COL32_A_MASK) == IM_COL32_A_MASK;
+		}
+
+		static constexpr int32 MaxVisibleRects = 32;
+
+		TBitArray<> CulledLists;
+		TArray<FOccluder> Occluders;
+		TMap<const ImDrawList*, int32> ListIndices;
+		TArray<ImRect, TInlineAllocator<16>> VisibleRects;
+	};
+}
@@ -59,35 +59,16 @@ namespace ImGuiUtils
 		}
 #endif
 
-		TSharedPtr<ImGuiUtils::SImGuiViewportWidget> ViewportWidget = SNew(ImGuiUtils::SImGuiViewportWidget, MainViewportWidgetPtr, Viewport);
-		TSharedPtr<SWindow> ViewportWindow =
-			SNew(SWindow)
-			.MinWidth(0.f)
-			.MinHeight(0.f)
-			.LayoutBorder({ 0 })
-			.SizingRule(ESizingRule::FixedSize)
-			.UserResizeBorder(FMargin(0))
-			.HasCloseButton(false)
-			.CreateTitleBar(false)
-			.IsPopupWindow(bPopupWindow)
-			.IsTopmostWindow(bTooltipWindow)
-			.Type(bTooltipWindow ? EWindowType::ToolTip : (bPopupWindow ? EWindowType::Menu : EWindowType::Normal))
-			.UseOSWindowBorder(false)
-			.FocusWhenFirstShown(bFocusWindowOnAppearing)
-			.ActivationPolicy(bFocusWindowOnAppearing ? EWindowActivationPolicy::Always : EWindowActivationPolicy::Never)
-			.Content()
-			[
-				ViewportWidget.ToSharedRef()
-			];
-
-		if (TSharedPtr<SWindow> ParentWindow = ParentWindowPtr.Pin())
-		{
-			FSlateApplication::Get().AddWindowAsNativeChild(ViewportWindow.ToSharedRef(), ParentWindow.ToSharedRef(), /*bShowImmediately=*/true);
-		}
-		else
-		{
-			FSlateApplication::Get().AddWindow(ViewportWindow.ToSharedRef(), /*bShowImmediately=*/true);
-		}
+		FViewportWindowParams WindowParams;
+		WindowParams.ParentWindow = ParentWindowPtr;
+		WindowParams.bTooltipWindow = bTooltipWindow;
+		WindowParams.bPopupWindow = bPopupWindow;
+		WindowParams.bFocusWindowOnAppearing = bFocusWindowOnAppearing;
+
+		// hidden windows are reused when possible, ImGui sets position/size/title before showing it
+		TSharedPtr<ImGuiUtils::SImGuiViewportWidget> ViewportWidget = nullptr;
+		bool bReusedWindow = false;
+		TSharedRef<SWindow> ViewportWindow = ViewportWindowPool.AcquireWindow(WindowParams, MainViewportWidgetPtr, Viewport, ViewportWidget, bReusedWindow);
 
 		FImGuiViewportData* ViewportData = IM_NEW(FImGuiViewportData)();
 		ViewportData->ViewportWindow = ViewportWindow;
@@ -95,6 +76,8 @@ namespace ImGuiUtils
 		ViewportData->ParentWindow = ParentWindowPtr;
 		ViewportData->MainViewportWidget = MainViewportWidgetPtr;
 		ViewportData->bFocusRequested = bFocusWidgetOnAppearing;
+		ViewportData->bActivateOnShow = bReusedWindow && bFocusWindowOnAppearing;
+		ViewportData->WindowParams = WindowParams;
 		ViewportData->OnWindowClosedHandle = ViewportWindow->GetOnWindowClosedEvent().AddLambda(
 			[Viewport](TSharedPtr<SWindow> Window)
 			{
@@ -113,17 +96,25 @@ namespace ImGuiUtils
 			if (TSharedPtr<SWindow> ViewportWindow = ViewportData->ViewportWindow.Pin())
 			{
 				ViewportWindow->GetOnWindowClosedEvent().Remove(ViewportData->OnWindowClosedHandle);
-				ViewportWindow->RequestDestroyWindow();
+				if (ViewportData->ViewportWidget)
+				{
+					// shared ptr can live around for a few frames (or in the pool), so make sure references to ImGui data is released
+					ViewportData->ViewportWidget->ResetImGuiViewportData();
+				}
+				if (!ViewportWindowPool.ReleaseWindow(ViewportWindow.ToSharedRef(), ViewportData->ViewportWidget, ViewportData->WindowParams))
+				{
+					ViewportWindow->RequestDestroyWindow();
+				}
 			}
-			if (ViewportData->ViewportWidget)
+			else if (ViewportData->ViewportWidget)
 			{
-				// shared ptr can live around for a few frames, so make sure references to ImGui data is released
 				ViewportData->ViewportWidget->ResetImGuiViewportData();
 			}
 			ViewportData->ViewportWindow = nullptr;
 			ViewportData->ViewportWidget = nullptr;
 			ViewportData->ParentWindow = nullptr;
 			ViewportData->MainViewportWidget = nullptr;
+			ViewportData->WindowParams = {};
 			ViewportData->OnWindowClosedHandle.Reset();
 			IM_DELETE(ViewportData);
 
@@ -231,6 +222,13 @@ namespace ImGuiUtils
 			if (TSharedPtr<SWindow> ViewportWindow = ViewportData->ViewportWindow.Pin())
 			{
 				ViewportWindow->ShowWindow();
+
+				// pooled windows were already shown once (FocusWhenFirstShown doesn't apply anymore)
+				if (ViewportData->bActivateOnShow)
+				{
+					ViewportWindow->BringToFront(/*bForce=*/true);
+					ViewportData->bActivateOnShow = false;
+				}
 			}
 		}
 	}
@@ -337,23 +335,22 @@ namespace ImGuiUtils
 
 				if (bInvalidateWindow)
 				{
+					// window setup is stale, don't return it to the pool
+					ViewportData->WindowParams.ParentWindow = nullptr;
 					// TODO: maybe not ideal to access viewport as 'ImGuiViewportP', but there doesn't seem to be a way to request window recreation
 					ImGui::DestroyPlatformWindow((ImGuiViewportP*)Viewport);
 				}
 				else if (ViewportData->bFocusRequested)
 				{
-					// TODO: this could potentially spam if a lot of windows are created on the same frame.
+					// batched with the other viewports, only the last request of the frame is applied
 					ViewportData->bFocusRequested = false;
-					FSlateApplication::Get().SetAllUserFocus(ViewportData->ViewportWidget, EFocusCause::SetDirectly);
+					ViewportWidgetManager.RequestFocus(ViewportData->ViewportWidget);
 				}
 			}
 			else if (ViewportData->bFocusRequested)
 			{
 				ViewportData->bFocusRequested = false;
-				if (TSharedPtr<SImGuiWidgetBase> MainViewportWidget = ViewportData->MainViewportWidget.Pin())
-				{
-					FSlateApplication::Get().SetAllUserFocus(MainViewportWidget, EFocusCause::SetDirectly);
-				}
+				ViewportWidgetManager.RequestFocus(ViewportData->MainViewportWidget.Pin());
 			}
 		}
 	}
@@ -0,0 +1,176 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/ScopeExit.h"
+#include "ImGuiStbTrueType.h"
+
+static TAutoConsoleVariable<bool> CVarSdfFonts(
+	TEXT("imgui.Fonts.SDF"),
+	false,
+	TEXT("Draw the default font from a signed distance field atlas, a single bake is scaled to every font size (zoom/DPI) instead of baking glyphs per size."),
+	ECVF_ReadOnly);
+
+static TAutoConsoleVariable<int32> CVarSdfFontBakeSize(
+	TEXT("imgui.Fonts.SDFBakeSize"),
+	32,
+	TEXT("Font size (in pixels) of the signed distance field bake, larger sizes keep more detail when zooming in."),
+	ECVF_ReadOnly);
+
+namespace ImGuiUtils
+{
+	// font loader rasterizing glyphs as signed distance fields (distance to the outline in alpha, 0.5 on the outline)
+	// atlases using it are drawn with the `IMGUI_SDF_FONT` permutation of FImGuiPS, see UImGuiSubsystem::IsSdfFontTexture
+	// NOTE: same metrics as the stb_truetype loader, only the glyph bitmaps differ
+	class FImGuiSdfFontLoader
+	{
+	public:
+		static const ImFontLoader* Get()
+		{
+			static ImFontLoader FontLoader = []()
+				{
+					ImFontLoader Loader;
+					Loader.Name = "stb_truetype_sdf";
+					Loader.FontSrcInit = &FImGuiSdfFontLoader::FontSrcInit;
+					Loader.FontSrcDestroy = &FImGuiSdfFontLoader::FontSrcDestroy;
+					Loader.FontSrcContainsGlyph = &FImGuiSdfFontLoader::FontSrcContainsGlyph;
+					Loader.FontBakedInit = &FImGuiSdfFontLoader::FontBakedInit;
+					Loader.FontBakedLoadGlyph = &FImGuiSdfFontLoader::FontBakedLoadGlyph;
+					return Loader;
+				}();
+			return &FontLoader;
+		}
+
+	private:
+		struct FSourceData
+		{
+			stbtt_fontinfo FontInfo;
+			float ScaleFactor = 0.f;
+		};
+
+		// distance (in bake pixels) covered by the field outside of the outline, limits how far glyphs can be scaled down before edges alias
+		static constexpr int32 Padding = 4;
+		static constexpr uint8 OnEdgeValue = 128;
+		static constexpr float PixelDistanceScale = (float)OnEdgeValue / Padding;
+
+		static bool FontSrcInit(ImFontAtlas* Atlas, ImFontConfig* Src)
+		{
+			const int32 FontOffset = stbtt_GetFontOffsetForIndex((const unsigned char*)Src->FontData, Src->FontNo);
+			if (FontOffset < 0)
+			{
+				return false;
+			}
+
+			FSourceData* SourceData = IM_NEW(FSourceData);
+			if (!stbtt_InitFont(&SourceData->FontInfo, (const unsigned char*)Src->FontData, FontOffset))
+			{
+				IM_DELETE(SourceData);
+				return false;
+			}
+			Src->FontLoaderData = SourceData;
+
+			const float RefSize = Src->DstFont->Sources[0]->SizePixels;
+			if (Src->MergeMode && Src->SizePixels == 0.f)
+			{
+				Src->SizePixels = RefSize;
+			}
+
+			SourceData->ScaleFactor = stbtt_ScaleForPixelHeight(&SourceData->FontInfo, 1.f);
+			if (Src->MergeMode && Src->SizePixels != 0.f && RefSize != 0.f)
+			{
+				SourceData->ScaleFactor *= Src->SizePixels / RefSize;
+			}
+			SourceData->ScaleFactor *= Src->ExtraSizeScale;
+			return true;
+		}
+
+		static void FontSrcDestroy(ImFontAtlas* Atlas, ImFontConfig* Src)
+		{
+			IM_DELETE((FSourceData*)Src->FontLoaderData);
+			Src->FontLoaderData = nullptr;
+		}
+
+		static bool FontSrcContainsGlyph(ImFontAtlas* Atlas, ImFontConfig* Src, ImWchar Codepoint)
+		{
+			const FSourceData* SourceData = (const FSourceData*)Src->FontLoaderData;
+			return stbtt_FindGlyphIndex(&SourceData->FontInfo, (int)Codepoint) != 0;
+		}
+
+		static bool FontBakedInit(ImFontAtlas* Atlas, ImFontConfig* Src, ImFontBaked* Baked, void* LoaderData)
+		{
+			if (!Src->MergeMode)
+			{
+				const FSourceData* SourceData = (const FSourceData*)Src->FontLoaderData;
+				const float ScaleForLayout = SourceData->ScaleFactor * Baked->Size / Src->ExtraSizeScale;
+
+				int32 Ascent = 0, Descent = 0, LineGap = 0;
+				stbtt_GetFontVMetrics(&SourceData->FontInfo, &Ascent, &Descent, &LineGap);
+				Baked->Ascent = ImCeil(Ascent * ScaleForLayout);
+				Baked->Descent = ImFloor(Descent * ScaleForLayout);
+			}
+			return true;
+		}
+
+		static bool FontBakedLoadGlyph(ImFontAtlas* Atlas, ImFontConfig* Src, ImFontBaked* Baked, void* LoaderData, ImWchar Codepoint, ImFontGlyph* OutGlyph, float* OutAdvanceX)
+		{
+			const FSourceData* SourceData = (const FSourceData*)Src->FontLoaderData;
+			const int32 GlyphIndex = stbtt_FindGlyphIndex(&SourceData->FontInfo, (int)Codepoint);
+			if (GlyphIndex == 0)
+			{
+				return false;
+			}
+
+			const float ScaleForLayout = SourceData->ScaleFactor * Baked->Size;
+			const float RasterizerDensity = Src->RasterizerDensity * Baked->RasterizerDensity;
+
+			int32 Advance = 0, LeftSideBearing = 0;
+			stbtt_GetGlyphHMetrics(&SourceData->FontInfo, GlyphIndex, &Advance, &LeftSideBearing);
+
+			// metrics only
+			if (OutAdvanceX)
+			{
+				*OutAdvanceX = Advance * ScaleForLayout;
+				return true;
+			}
+
+			OutGlyph->Codepoint = Codepoint;
+			OutGlyph->AdvanceX = Advance * ScaleForLayout;
+
+			int32 Width = 0, Height = 0, OffsetX = 0, OffsetY = 0;
+			unsigned char* Pixels = nullptr;
+			{
+				// outline and field scratch buffers are released before the glyph load returns
+				FImGuiTransientMemoryScope TransientScope;
+				Pixels = stbtt_GetGlyphSDF(&SourceData->FontInfo, ScaleForLayout * RasterizerDensity, GlyphIndex, Padding, OnEdgeValue, PixelDistanceScale, &Width, &Height, &OffsetX, &OffsetY);
+			}
+			if (!Pixels)
+			{
+				// glyph without an outline (space etc..)
+				return true;
+			}
+			ON_SCOPE_EXIT{ stbtt_FreeSDF(Pixels, nullptr); };
+
+			const ImFontAtlasRectId PackId = ImFontAtlasPackAddRect(Atlas, Width, Height);
+			if (PackId == ImFontAtlasRectId_Invalid)
+			{
+				return false;
+			}
+			ImTextureRect* Rect = ImFontAtlasPackGetRect(Atlas, PackId);
+
+			const float RefSize = Baked->OwnerFont->Sources[0]->SizePixels;
+			const float OffsetsScale = (RefSize != 0.f) ? (Baked->Size / RefSize) : 1.f;
+			const float FontOffsetX = ImFloor(Src->GlyphOffset.x * OffsetsScale + 0.5f);
+			const float FontOffsetY = ImFloor(Src->GlyphOffset.y * OffsetsScale + 0.5f) + IM_ROUND(Baked->Ascent);
+
+			// padding is part of the glyph quad, the field fades out inside of it
+			OutGlyph->X0 = OffsetX / RasterizerDensity + FontOffsetX;
+			OutGlyph->Y0 = OffsetY / RasterizerDensity + FontOffsetY;
+			OutGlyph->X1 = (OffsetX + Width) / RasterizerDensity + FontOffsetX;
+			OutGlyph->Y1 = (OffsetY + Height) / RasterizerDensity + FontOffsetY;
+			OutGlyph->Visible = true;
+			OutGlyph->PackId = PackId;
+			ImFontAtlasBakedSetFontGlyphBitmap(Atlas, Baked, Src, OutGlyph, Rect, Pixels, ImTextureFormat_Alpha8, Width);
+			return true;
+		}
+	};
+}
@@ -0,0 +1,207 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#include "ImGuiPluginTypes.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarShapesEnable(
+	TEXT("imgui.Shapes.Enable"),
+	true,
+	TEXT("Draw ImGuiShapes calls as single quads with analytic coverage, when disabled (or not supported by the renderer) shapes are tessellated by ImDrawList."));
+
+namespace ImGuiShapes
+{
+	// NOTE: must match the IMGUI_SDF_SHAPES permutation in ImGuiShader.usf
+	// shape params are quantized to 1/4 pixel and packed in the vertex UVs (integers stored as float, sign is the quad corner)
+	//   abs(UV.x) - 1 = (HalfSize.x << 11) | RoundingCode
+	//   abs(UV.y) - 1 = (HalfSize.y << 11) | ThicknessCode
+	static constexpr float Precision = 4.f;
+	static constexpr int32 HalfSizeBits = 13;
+	static constexpr int32 ParamBits = 11;
+	static constexpr int32 MaxHalfSizeCode = (1 << HalfSizeBits) - 1;
+	static constexpr int32 MaxParamCode = (1 << ParamBits) - 1;
+	// rounding code for circles/pills (rounding is the smaller half size), keeps them independent of the rounding range
+	static constexpr int32 FullRoundingCode = MaxParamCode;
+	// anti-aliasing margin around the shape
+	static constexpr float Padding = 1.f;
+
+	static bool IsEnabled()
+	{
+#if WITH_ENGINE && IMGUI_ALLOW_LOCAL_DRAWING
+		// NetImgui draws with its own renderer, which would show the packed quads as is
+		const FImGuiTickContext* TickContext = FImGuiTickContext::GetTickContextFromImGuiContext(ImGui::GetCurrentContext());
+		return CVarShapesEnable.GetValueOnGameThread() && !(TickContext && TickContext->bIsDrawingRemotely);
+#else
+		return false;
+#endif
+	}
+
+	// rounded rect centered at `Center` with `Axis` (normalized) as its local x axis, returns false when the params can't be packed
+	static bool AddShape(ImDrawList* DrawList, const ImVec2& Center, const ImVec2& Axis, const ImVec2& HalfSize, float Rounding, float Thickness, ImU32 Color)
+	{
+		const int32 HalfSizeCodeX = FMath::RoundToInt(FMath::Max(HalfSize.x, 0.f) * Precision);
+		const int32 HalfSizeCodeY = FMath::RoundToInt(FMath::Max(HalfSize.y, 0.f) * Precision);
+		if (HalfSizeCodeX > MaxHalfSizeCode || HalfSizeCodeY > MaxHalfSizeCode)
+		{
+			return false;
+		}
+
+		int32 RoundingCode = FullRoundingCode;
+		if (Rounding < FMath::Min(HalfSize.x, HalfSize.y))
+		{
+			RoundingCode = FMath::RoundToInt(FMath::Max(Rounding, 0.f) * Precision);
+			if (RoundingCode >= FullRoundingCode)
+			{
+				return false;
+			}
+		}
+
+		// 0 is a filled shape, thin outlines are kept at the smallest step
+		const int32 ThicknessCode = (Thickness > 0.f) ? FMath::Max(FMath::RoundToInt(Thickness * Precision), 1) : 0;
+		if (ThicknessCode > MaxParamCode)
+		{
+			return false;
+		}
+
+		// quad covers the quantized shape, outline and anti-aliasing margin
+		const float OuterMargin = Padding + ThicknessCode / Precision * 0.5f;
+		const ImVec2 Extent = ImVec2(HalfSizeCodeX / Precision + OuterMargin, HalfSizeCodeY / Precision + OuterMargin);
+		const ImVec2 ExtentX = Axis * Extent.x;
+		const ImVec2 ExtentY = ImVec2(-Axis.y, Axis.x) * Extent.y;
+
+		const float PackedX = (float)(1 + (HalfSizeCodeX << ParamBits) + RoundingCode);
+		const float PackedY = (float)(1 + (HalfSizeCodeY << ParamBits) + ThicknessCode);
+
+		DrawList->PrimReserve(6, 4);
+		const ImDrawIdx Index = (ImDrawIdx)DrawList->_VtxCurrentIdx;
+		DrawList->PrimWriteIdx(Index);
+		DrawList->PrimWriteIdx(Index + 1);
+		DrawList->PrimWriteIdx(Index + 2);
+		DrawList->PrimWriteIdx(Index);
+		DrawList->PrimWriteIdx(Index + 2);
+		DrawList->PrimWriteIdx(Index + 3);
+		DrawList->PrimWriteVtx(Center - ExtentX - ExtentY, ImVec2(-PackedX, -PackedY), Color);
+		DrawList->PrimWriteVtx(Center + ExtentX - ExtentY, ImVec2(PackedX, -PackedY), Color);
+		DrawList->PrimWriteVtx(Center + ExtentX + ExtentY, ImVec2(PackedX, PackedY), Color);
+		DrawList->PrimWriteVtx(Center - ExtentX + ExtentY, ImVec2(-PackedX, PackedY), Color);
+		return true;
+	}
+
+	// shapes too large to pack are drawn by ImDrawList, shape rendering is paused around them
+	template <typename DrawFunc>
+	static void AddTessellated(ImDrawList* DrawList, DrawFunc Draw)
+	{
+		DrawList->AddCallback(ImDrawCallback_SetShapeRendering, nullptr);
+		Draw();
+		DrawList->AddCallback(ImDrawCallback_SetShapeRendering, (void*)1);
+	}
+
+	void BeginShapes(ImDrawList* DrawList)
+	{
+		if (IsEnabled())
+		{
+			DrawList->AddCallback(ImDrawCallback_SetShapeRendering, (void*)1);
+		}
+	}
+
+	void EndShapes(ImDrawList* DrawList)
+	{
+		if (IsEnabled())
+		{
+			DrawList->AddCallback(ImDrawCallback_SetShapeRendering, nullptr);
+		}
+	}
+
+	void AddRectFilled(ImDrawList* DrawList, const ImVec2& Min, const ImVec2& Max, ImU32 Color, float Rounding)
+	{
+		if ((Color & IM_COL32_A_MASK) == 0)
+		{
+			return;
+		}
+
+		if (!IsEnabled())
+		{
+			DrawList->AddRectFilled(Min, Max, Color, Rounding);
+		}
+		else if (!AddShape(DrawList, (Min + Max) * 0.5f, ImVec2(1.f, 0.f), (Max - Min) * 0.5f, Rounding, 0.f, Color))
+		{
+			AddTessellated(DrawList, [&]() { DrawList->AddRectFilled(Min, Max, Color, Rounding); });
+		}
+	}
+
+	void AddRect(ImDrawList* DrawList, const ImVec2& Min, const ImVec2& Max, ImU32 Color, float Rounding, float Thickness)
+	{
+		if ((Color & IM_COL32_A_MASK) == 0)
+		{
+			return;
+		}
+
+		// same as ImDrawList::AddRect, the outline is centered half a pixel inside of the rect
+		if (!IsEnabled())
+		{
+			DrawList->AddRect(Min, Max, Color, Rounding, 0, Thickness);
+		}
+		else if (!AddShape(DrawList, (Min + Max) * 0.5f, ImVec2(1.f, 0.f), (Max - Min) * 0.5f - ImVec2(0.5f, 0.5f), Rounding, Thickness, Color))
+		{
+			AddTessellated(DrawList, [&]() { DrawList->AddRect(Min, Max, Color, Rounding, 0, Thickness); });
+		}
+	}
+
+	void AddCircleFilled(ImDrawList* DrawList, const ImVec2& Center, float Radius, ImU32 Color)
+	{
+		if ((Color & IM_COL32_A_MASK) == 0 || Radius < 0.5f)
+		{
+			return;
+		}
+
+		if (!IsEnabled())
+		{
+			DrawList->AddCircleFilled(Center, Radius, Color);
+		}
+		else if (!AddShape(DrawList, Center, ImVec2(1.f, 0.f), ImVec2(Radius, Radius), Radius, 0.f, Color))
+		{
+			AddTessellated(DrawList, [&]() { DrawList->AddCircleFilled(Center, Radius, Color); });
+		}
+	}
+
+	void AddCircle(ImDrawList* DrawList, const ImVec2& Center, float Radius, ImU32 Color, float Thickness)
+	{
+		if ((Color & IM_COL32_A_MASK) == 0 || Radius < 0.5f)
+		{
+			return;
+		}
+
+		// same as ImDrawList::AddCircle, the outline is centered half a pixel inside of the radius
+		if (!IsEnabled())
+		{
+			DrawList->AddCircle(Center, Radius, Color, 0, Thickness);
+		}
+		else if (!AddShape(DrawList, Center, ImVec2(1.f, 0.f), ImVec2(Radius - 0.5f, Radius - 0.5f), Radius, Thickness, Color))
+		{
+			AddTessellated(DrawList, [&]() { DrawList->AddCircle(Center, Radius, Color, 0, Thickness); });
+		}
+	}
+
+	void AddLine(ImDrawList* DrawList, const ImVec2& P1, const ImVec2& P2, ImU32 Color, float Thickness)
+	{
+		if ((Color & IM_COL32_A_MASK) == 0)
+		{
+			return;
+		}
+
+		const ImVec2 Direction = P2 - P1;
+		const float Length = ImSqrt(ImLengthSqr(Direction));
+		if (!IsEnabled())
+		{
+			DrawList->AddLine(P1, P2, Color, Thickness);
+		}
+		else if (Length > 0.f)
+		{
+			// same as ImDrawList::AddLine, lines go through pixel centers and have butt caps
+			const ImVec2 Center = (P1 + P2) * 0.5f + ImVec2(0.5f, 0.5f);
+			if (!AddShape(DrawList, Center, Direction / Length, ImVec2(Length * 0.5f, Thickness * 0.5f), 0.f, 0.f, Color))
+			{
+				AddTessellated(DrawList, [&]() { DrawList->AddLine(P1, P2, Color, Thickness); });
+			}
+		}
+	}
+}
@@ -0,0 +1,17 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#pragma once
+
+// stb_truetype is only compiled into ImGui when FreeType is disabled (and is private to imgui_draw.cpp), the SDF font loader and
+// background glyph bakes share this copy
+// NOTE: same allocator as ImGui's copy, which is safe to call from the glyph baking tasks (see ImGuiMemory::Malloc)
+#ifndef STB_TRUETYPE_IMPLEMENTATION
+THIRD_PARTY_INCLUDES_START
+#define STBTT_malloc(x,u)	((void)(u), IM_ALLOC(x))
+#define STBTT_free(x,u)		((void)(u), IM_FREE(x))
+#define STBTT_assert(x)		do { IM_ASSERT(x); } while(0)
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "imgui/imstb_truetype.h"
+THIRD_PARTY_INCLUDES_END
+#endif
@@ -0,0 +1,355 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#include "ImGuiPluginTypes.h"
+#include "ImGuiSubsystem.h"
+#include "Hash/CityHash.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<bool> CVarTextCacheEnable(
+	TEXT("imgui.TextCache.Enable"),
+	true,
+	TEXT("Cache text sizes and glyph quads for ImGuiTextCache calls, when disabled the calls go straight to ImGui."));
+
+static TAutoConsoleVariable<int32> CVarTextCacheMaxEntries(
+	TEXT("imgui.TextCache.MaxEntries"),
+	8192,
+	TEXT("Number of cached strings (per font and size), entries not used in the last frames are dropped once the limit is reached."));
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Text Cache Hits"), STAT_ImGui_TextCacheHits, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Text Cache Misses"), STAT_ImGui_TextCacheMisses, STATGROUP_ImGui);
+DECLARE_MEMORY_STAT(TEXT("Text Cache"), STAT_ImGui_TextCacheMemory, STATGROUP_ImGui);
+
+namespace ImGuiTextCache
+{
+	struct FCachedText
+	{
+		// compared on lookup, a hash collision must not draw someone else's label (or use another font)
+		TArray<ANSICHAR> Text;
+		const ImFont* Font = nullptr;
+		const ImFontAtlas* FontAtlas = nullptr;
+		ImGuiID FontId = 0;
+		float FontSize = 0.f;
+
+		ImVec2 Size = ImVec2(0.f, 0.f);
+		// glyphs loaded since the size was measured (deferred glyphs baked, pending glyphs replaced) can change it
+		ImGuiID SizeBakedId = 0;
+		int32 SizeBakedGlyphCount = 0;
+
+		// glyph quads relative to the text position, built the first time the text is drawn
+		// NOTE: white vertices are colored glyphs (drawn untinted), see BuildGeometry
+		TArray<ImDrawVert> Vertices;
+		TArray<ImDrawIdx> Indices;
+		// uvs/glyphs are only valid for the bake and atlas texture they were built from
+		ImGuiID BakedId = 0;
+		int32 BakedGlyphCount = 0;
+		int32 TextureUniqueID = 0;
+		bool bHasGeometry = false;
+
+		uint64 LastUsedFrame = 0;
+
+		SIZE_T GetAllocatedSize() const
+		{
+			return Text.GetAllocatedSize() + Vertices.GetAllocatedSize() + Indices.GetAllocatedSize();
+		}
+	};
+
+	struct FCacheCounters
+	{
+		uint64 SizeHits = 0;
+		uint64 SizeMisses = 0;
+		uint64 GeometryHits = 0;
+		uint64 GeometryMisses = 0;
+	};
+
+	// NOTE: game thread only
+	static TMap<uint64, FCachedText> CachedTexts;
+	static FCacheCounters Counters;
+	static SIZE_T MemoryUsage = 0;
+	// glyph quads are built by ImGui into this draw list and copied out
+	static ImDrawList ScratchDrawList(nullptr);
+
+	static void UpdateMemoryStat()
+	{
+		SET_MEMORY_STAT(STAT_ImGui_TextCacheMemory, MemoryUsage);
+	}
+
+	static void TrimCache()
+	{
+		const int32 MaxEntries = FMath::Max(CVarTextCacheMaxEntries.GetValueOnGameThread(), 1);
+		if (CachedTexts.Num() < MaxEntries)
+		{
+			return;
+		}
+
+		// labels drawn every frame stay, everything else goes
+		const uint64 MinUsedFrame = GFrameCounter > 2 ? GFrameCounter - 2 : 0;
+		for (auto It = CachedTexts.CreateIterator(); It; ++It)
+		{
+			if (It.Value().LastUsedFrame < MinUsedFrame)
+			{
+				MemoryUsage -= It.Value().GetAllocatedSize();
+				It.RemoveCurrent();
+			}
+		}
+
+		// working set doesn't fit, start over
+		if (CachedTexts.Num() >= MaxEntries)
+		{
+			CachedTexts.Reset();
+			MemoryUsage = 0;
+		}
+		UpdateMemoryStat();
+	}
+
+	static bool IsSameText(const FCachedText& CachedText, ImFont* Font, float FontSize, const char* Text, int32 TextLength)
+	{
+		// font ids are only unique within an atlas (and the SDF font has its own), pointers can be reused once a font is destroyed
+		return CachedText.Font == Font
+			&& CachedText.FontAtlas == Font->OwnerAtlas
+			&& CachedText.FontId == Font->FontId
+			&& CachedText.FontSize == FontSize
+			&& CachedText.Text.Num() == TextLength
+			&& FMemory::Memcmp(CachedText.Text.GetData(), Text, TextLength) == 0;
+	}
+
+	// text size is measured when the entry is added, and again once the bake it was measured with got new glyphs
+	static FCachedText& FindOrAdd(ImFont* Font, float FontSize, const char* Text, const char* TextEnd)
+	{
+		const int32 TextLength = (int32)(TextEnd - Text);
+		const void* FontKey[2] = { Font->OwnerAtlas, Font };
+		const uint64 Seed = CityHash64WithSeed((const char*)FontKey, sizeof(FontKey), (uint64)FMath::AsUInt(FontSize));
+		const uint64 Key = CityHash64WithSeed(Text, TextLength, Seed);
+
+		FCachedText* CachedText = CachedTexts.Find(Key);
+		const ImFontBaked* Baked = Font->GetFontBaked(FontSize);
+		const ImGuiID BakedId = Baked ? Baked->BakedId : 0;
+		const int32 BakedGlyphCount = Baked ? Baked->Glyphs.Size : 0;
+		if (CachedText && IsSameText(*CachedText, Font, FontSize, Text, TextLength))
+		{
+			if (CachedText->SizeBakedId == BakedId && CachedText->SizeBakedGlyphCount == BakedGlyphCount)
+			{
+				++Counters.SizeHits;
+				INC_DWORD_STAT(STAT_ImGui_TextCacheHits);
+				CachedText->LastUsedFrame = GFrameCounter;
+				return *CachedText;
+			}
+		}
+		else if (CachedText)
+		{
+			// collision, latest string wins
+			MemoryUsage -= CachedText->GetAllocatedSize();
+			*CachedText = FCachedText();
+		}
+		else
+		{
+			TrimCache();
+			CachedText = &CachedTexts.Add(Key);
+		}
+
+		++Counters.SizeMisses;
+		INC_DWORD_STAT(STAT_ImGui_TextCacheMisses);
+
+		if (CachedText->Text.IsEmpty())
+		{
+			CachedText->Text.Append(Text, TextLength);
+			CachedText->Font = Font;
+			CachedText->FontAtlas = Font->OwnerAtlas;
+			CachedText->FontId = Font->FontId;
+			CachedText->FontSize = FontSize;
+			MemoryUsage += CachedText->GetAllocatedSize();
+			UpdateMemoryStat();
+		}
+
+		// same as ImGui::CalcTextSize
+		CachedText->Size = Font->CalcTextSizeA(FontSize, FLT_MAX, -1.f, Text, TextEnd, nullptr);
+		CachedText->Size.x = ImCeilFast(CachedText->Size.x);
+
+		// measuring can load glyphs, read state afterwards
+		Baked = Font->GetFontBaked(FontSize);
+		CachedText->SizeBakedId = Baked ? Baked->BakedId : 0;
+		CachedText->SizeBakedGlyphCount = Baked ? Baked->Glyphs.Size : 0;
+
+		CachedText->LastUsedFrame = GFrameCounter;
+		return *CachedText;
+	}
+
+	static bool HasValidGeometry(const FCachedText& CachedText, ImFont* Font, float FontSize)
+	{
+		if (!CachedText.bHasGeometry)
+		{
+			return false;
+		}
+		// glyphs loaded (or deferred glyphs baked) since the quads were built may change the text, atlas repacks move uvs
+		const ImFontBaked* Baked = Font->GetFontBaked(FontSize);
+		return Baked
+			&& Baked->BakedId == CachedText.BakedId
+			&& Baked->Glyphs.Size == CachedText.BakedGlyphCount
+			&& Font->OwnerAtlas->TexData->UniqueID == CachedText.TextureUniqueID;
+	}
+
+	static void BuildGeometry(FCachedText& CachedText, ImFont* Font, float FontSize, const char* Text, const char* TextEnd)
+	{
+		// NOTE: not registered with the shared data, the context doesn't need to know about this draw list
+		ScratchDrawList._Data = &GImGui->DrawListSharedData;
+		ScratchDrawList._ResetForNewFrame();
+		// black tints glyphs, colored glyphs are drawn with the untinted (white) color
+		const ImVec4 NoClipRect(-FLT_MAX, -FLT_MAX, FLT_MAX, FLT_MAX);
+		Font->RenderText(&ScratchDrawList, FontSize, ImVec2(0.f, 0.f), IM_COL32_BLACK, NoClipRect, Text, TextEnd);
+		ScratchDrawList._Data = nullptr;
+
+		MemoryUsage -= CachedText.GetAllocatedSize();
+		CachedText.Vertices = TArray<ImDrawVert>(ScratchDrawList.VtxBuffer.Data, ScratchDrawList.VtxBuffer.Size);
+		CachedText.Indices = TArray<ImDrawIdx>(ScratchDrawList.IdxBuffer.Data, ScratchDrawList.IdxBuffer.Size);
+		MemoryUsage += CachedText.GetAllocatedSize();
+		UpdateMemoryStat();
+
+		// rendering can load glyphs (and grow the texture), read state afterwards
+		const ImFontBaked* Baked = Font->GetFontBaked(FontSize);
+		CachedText.BakedId = Baked ? Baked->BakedId : 0;
+		CachedText.BakedGlyphCount = Baked ? Baked->Glyphs.Size : 0;
+		CachedText.TextureUniqueID = Font->OwnerAtlas->TexData->UniqueID;
+		CachedText.bHasGeometry = true;
+	}
+
+	ImVec2 CalcTextSize(const char* Text, const char* TextEnd, bool bHideTextAfterDoubleHash)
+	{
+		if (!CVarTextCacheEnable.GetValueOnGameThread())
+		{
+			return ImGui::CalcTextSize(Text, TextEnd, bHideTextAfterDoubleHash);
+		}
+
+		ImGuiContext& Context = *GImGui;
+		const char* TextDisplayEnd = bHideTextAfterDoubleHash ? ImGui::FindRenderedTextEnd(Text, TextEnd) : (TextEnd ? TextEnd : Text + ImStrlen(Text));
+		if (Text == TextDisplayEnd)
+		{
+			return ImVec2(0.f, Context.FontSize);
+		}
+
+		return FindOrAdd(Context.Font, Context.FontSize, Text, TextDisplayEnd).Size;
+	}
+
+	void AddText(ImDrawList* DrawList, const ImVec2& Pos, ImU32 Color, const char* Text, const char* TextEnd)
+	{
+		if ((Color & IM_COL32_A_MASK) == 0 || !Text || Text == TextEnd || Text[0] == 0)
+		{
+			return;
+		}
+
+		if (!CVarTextCacheEnable.GetValueOnGameThread())
+		{
+			DrawList->AddText(Pos, Color, Text, TextEnd);
+			return;
+		}
+
+		if (!TextEnd)
+		{
+			TextEnd = Text + ImStrlen(Text);
+		}
+
+		ImFont* Font = DrawList->_Data->Font;
+		const float FontSize = DrawList->_Data->FontSize;
+		FCachedText& CachedText = FindOrAdd(Font, FontSize, Text, TextEnd);
+
+		// same pixel snapping/culling as ImFont::RenderText
+		ImVec2 Origin = Pos;
+		if ((DrawList->Flags & ImDrawListFlags_TextNoPixelSnap) == 0)
+		{
+			Origin = ImVec2(IM_TRUNC(Origin.x), IM_TRUNC(Origin.y));
+		}
+		const ImVec4& ClipRect = DrawList->_CmdHeader.ClipRect;
+		if (Origin.y > ClipRect.w || Origin.y + CachedText.Size.y < ClipRect.y)
+		{
+			return;
+		}
+
+		if (HasValidGeometry(CachedText, Font, FontSize))
+		{
+			++Counters.GeometryHits;
+		}
+		else
+		{
+			++Counters.GeometryMisses;
+			BuildGeometry(CachedText, Font, FontSize, Text, TextEnd);
+		}
+
+		const int32 NumVertices = CachedText.Vertices.Num();
+		const int32 NumIndices = CachedText.Indices.Num();
+		if (NumVertices == 0)
+		{
+			return;
+		}
+		// 16 bit indices, very long strings go through ImGui which splits them into multiple commands
+		if (sizeof(ImDrawIdx) == 2 && NumVertices > 0xFFFF)
+		{
+			DrawList->AddText(Pos, Color, Text, TextEnd);
+			return;
+		}
+
+		DrawList->PrimReserve(NumIndices, NumVertices);
+
+		ImDrawVert* VertexDst = DrawList->_VtxWritePtr;
+		FMemory::Memcpy(VertexDst, CachedText.Vertices.GetData(), NumVertices * sizeof(ImDrawVert));
+		const ImU32 UntintedColor = Color | ~IM_COL32_A_MASK;
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; ++VertexIndex)
+		{
+			VertexDst[VertexIndex].pos += Origin;
+			VertexDst[VertexIndex].col = (VertexDst[VertexIndex].col == IM_COL32_WHITE) ? UntintedColor : Color;
+		}
+
+		const ImDrawIdx BaseIndex = (ImDrawIdx)DrawList->_VtxCurrentIdx;
+		ImDrawIdx* IndexDst = DrawList->_IdxWritePtr;
+		for (int32 Index = 0; Index < NumIndices; ++Index)
+		{
+			IndexDst[Index] = BaseIndex + CachedText.Indices[Index];
+		}
+
+		DrawList->_VtxWritePtr += NumVertices;
+		DrawList->_IdxWritePtr += NumIndices;
+		DrawList->_VtxCurrentIdx += NumVertices;
+	}
+
+	void TextUnformatted(const char* Text, const char* TextEnd)
+	{
+		ImGuiWindow* Window = ImGui::GetCurrentWindow();
+		if (Window->SkipItems)
+		{
+			return;
+		}
+
+		// same as ImGui::TextEx for single line text
+		const ImVec2 TextPos(Window->DC.CursorPos.x, Window->DC.CursorPos.y + Window->DC.CurrLineTextBaseOffset);
+		const ImVec2 TextSize = CalcTextSize(Text, TextEnd);
+		const ImRect Bounds(TextPos, TextPos + TextSize);
+		ImGui::ItemSize(TextSize, 0.f);
+		if (!ImGui::ItemAdd(Bounds, 0))
+		{
+			return;
+		}
+
+		AddText(Window->DrawList, Bounds.Min, ImGui::GetColorU32(ImGuiCol_Text), Text, TextEnd);
+		if (GImGui->LogEnabled)
+		{
+			ImGui::LogRenderedText(&Bounds.Min, Text, TextEnd);
+		}
+	}
+
+	void Reset()
+	{
+		CachedTexts.Empty();
+		ScratchDrawList._ClearFreeMemory();
+		MemoryUsage = 0;
+		UpdateMemoryStat();
+	}
+
+	static FAutoConsoleCommandWithOutputDevice CmdReportTextCache(
+		TEXT("imgui.TextCache.Report"),
+		TEXT("Reports ImGui text cache entries, memory and hit rates."),
+		FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+			{
+				auto GetHitRate = [](uint64 Hits, uint64 Misses) { return (Hits + Misses) > 0 ? (100.0 * Hits / (Hits + Misses)) : 0.0; };
+
+				Ar.Logf(TEXT("ImGui text cache: %d entries, %.1f KB"), CachedTexts.Num(), MemoryUsage / 1024.0);
+				Ar.Logf(TEXT("  sizes    : %llu hits, %llu misses (%.1f%% hit rate)"), Counters.SizeHits, Counters.SizeMisses, GetHitRate(Counters.SizeHits, Counters.SizeMisses));
+				Ar.Logf(TEXT("  geometry : %llu hits, %llu rebuilds (%.1f%% hit rate)"), Counters.GeometryHits, Counters.GeometryMisses, GetHitRate(Counters.GeometryHits, Counters.GeometryMisses));
+			}));
+}
@@ -0,0 +1,251 @@
+// Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
+
+#include "Trace/Trace.h"
+#include "Trace/Trace.inl"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+#define IMGUI_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+
+#if IMGUI_TRACE_ENABLED
+
+// enable with `-trace=default,imgui` or `Trace.Enable ImGui`
+UE_TRACE_CHANNEL_DEFINE(ImGuiChannel)
+
+UE_TRACE_EVENT_BEGIN(ImGui, WidgetFrame)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint32, FrameNumber)
+	UE_TRACE_EVENT_FIELD(uint32, ImGuiFrameCount)
+	UE_TRACE_EVENT_FIELD(uint32, VertexCount)
+	UE_TRACE_EVENT_FIELD(uint32, IndexCount)
+	UE_TRACE_EVENT_FIELD(uint32, DrawCmdCount)
+	UE_TRACE_EVENT_FIELD(uint32, TextureSwitchCount)
+	UE_TRACE_EVENT_FIELD(uint32, FontAtlasUploadCount)
+	UE_TRACE_EVENT_FIELD(uint32, WindowCount)
+	UE_TRACE_EVENT_FIELD(uint32, ViewportCount)
+	UE_TRACE_EVENT_FIELD(uint64, NewFrameCycles)
+	UE_TRACE_EVENT_FIELD(uint64, TickCycles)
+	UE_TRACE_EVENT_FIELD(uint64, RenderCycles)
+	UE_TRACE_EVENT_FIELD(UE::Trace::AnsiString, ContextName)
+UE_TRACE_EVENT_END()
+
+#endif //#if IMGUI_TRACE_ENABLED
+
+// NOTE: counted on the game thread from the generated draw data, so these work without a renderer (NullRHI)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Triangles"), STAT_ImGui_Triangles, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Draw Calls"), STAT_ImGui_DrawCalls, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("PSO Switches"), STAT_ImGui_PSOSwitches, STATGROUP_ImGui);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bytes Uploaded"), STAT_ImGui_BytesUploaded, STATGROUP_ImGui);
+
+CSV_DEFINE_CATEGORY(ImGui, true);
+
+namespace ImGuiUtils
+{
+	// draw work submitted by a context in a frame (all viewports)
+	struct FImGuiDrawStats
+	{
+		void Gather(const ImGuiContext* Context)
+		{
+			for (const ImGuiViewport* Viewport : Context->PlatformIO.Viewports)
+			{
+				const ImDrawData* DrawData = Viewport->DrawData;
+				if (!DrawData || !DrawData->Valid || DrawData->TotalIdxCount <= 0)
+				{
+					continue;
+				}
+
+				VertexCount += DrawData->TotalVtxCount;
+				IndexCount += DrawData->TotalIdxCount;
+				UploadBytes += DrawData->TotalVtxCount * sizeof(ImDrawVert) + DrawData->TotalIdxCount * sizeof(ImDrawIdx);
+
+				// pipeline is set once per viewport pass and again after every user callback
+				PSOSwitchCount++;
+
+				// NOTE: compare texture refs, atlas textures might not have an id assigned yet
+				ImTextureRef LastTextureRef;
+				bool bHasTextureRef = false;
+				for (const ImDrawList* DrawList : DrawData->CmdLists)
+				{
+					DrawCmdCount += DrawList->CmdBuffer.Size;
+					for (const ImDrawCmd& DrawCmd : DrawList->CmdBuffer)
+					{
+						if (DrawCmd.UserCallback != nullptr)
+						{
+							if (DrawCmd.UserCallback != ImDrawCallback_ResetRenderState && DrawCmd.UserCallback != ImDrawCallback_SetShaderState &&
+								DrawCmd.UserCallback != ImDrawCallback_SetSamplerStatePoint && DrawCmd.UserCallback != ImDrawCallback_ResetSamplerState)
+							{
+								PSOSwitchCount++;
+							}
+							continue;
+						}
+
+						// upper bound, draws with an empty scissor rect are skipped by the renderer
+						DrawCallCount++;
+						TriangleCount += DrawCmd.ElemCount / 3;
+
+						if (!bHasTextureRef || DrawCmd.TexRef != LastTextureRef)
+						{
+							LastTextureRef = DrawCmd.TexRef;
+							bHasTextureRef = true;
+							TextureSwitchCount++;
+						}
+					}
+				}
+			}
+		}
+
+		void Report() const
+		{
+			INC_DWORD_STAT_BY(STAT_ImGui_Triangles, TriangleCount);
+			INC_DWORD_STAT_BY(STAT_ImGui_DrawCalls, DrawCallCount);
+			INC_DWORD_STAT_BY(STAT_ImGui_PSOSwitches, PSOSwitchCount);
+			INC_DWORD_STAT_BY(STAT_ImGui_BytesUploaded, (uint32)UploadBytes);
+
+			CSV_CUSTOM_STAT(ImGui, Triangles, (int32)TriangleCount, ECsvCustomStatOp::Accumulate);
+			CSV_CUSTOM_STAT(ImGui, DrawCalls, (int32)DrawCallCount, ECsvCustomStatOp::Accumulate);
+			CSV_CUSTOM_STAT(ImGui, PSOSwitches, (int32)PSOSwitchCount, ECsvCustomStatOp::Accumulate);
+			CSV_CUSTOM_STAT(ImGui, BytesUploaded, (int32)UploadBytes, ECsvCustomStatOp::Accumulate);
+		}
+
+		uint32 VertexCount = 0;
+		uint32 IndexCount = 0;
+		uint32 DrawCmdCount = 0;
+		uint32 DrawCallCount = 0;
+		uint32 TriangleCount = 0;
+		uint32 TextureSwitchCount = 0;
+		uint32 PSOSwitchCount = 0;
+		uint64 UploadBytes = 0;
+	};
+
+	// per widget frame stats, timings are only collected while the trace channel is enabled
+	struct FImGuiFrameTrace
+	{
+		static bool IsEnabled()
+		{
+#if IMGUI_TRACE_ENABLED
+			return UE_TRACE_CHANNELEXPR_IS_ENABLED(ImGuiChannel);
+#else
+			return false;
+#endif
+		}
+
+		// draw stats walk every draw list, skip them unless something consumes them
+		static bool IsDrawStatsEnabled()
+		{
+#if STATS
+			if (FThreadStats::IsCollectingData())
+			{
+				return true;
+			}
+#endif
+#if CSV_PROFILER
+			if (FCsvProfiler::Get()->IsCapturing())
+			{
+				return true;
+			}
+#endif
+			return IsEnabled();
+		}
+
+		// NOTE: call before ImGui::Render, atlas textures are marked as uploaded once the renderer picks them up
+		void CountFontAtlasUploads(const ImGuiPlatformIO& PlatformIO)
+		{
+			FontAtlasUploadCount = 0;
+			FontAtlasUploadBytes = 0;
+			for (const ImTextureData* TexData : PlatformIO.Textures)
+			{
+				if (TexData->Status == ImTextureStatus_WantCreate)
+				{
+					FontAtlasUploadCount++;
+					FontAtlasUploadBytes += TexData->GetSizeInBytes();
+				}
+				else if (TexData->Status == ImTextureStatus_WantUpdates)
+				{
+					FontAtlasUploadCount++;
+					FontAtlasUploadBytes += TexData->UpdateRect.w * TexData->UpdateRect.h * TexData->BytesPerPixel;
+				}
+			}
+		}
+
+		// call after ImGui::Render, reports stat/csv counters and emits the trace event
+		void EndFrame(const ImGuiContext* Context)
+		{
+#if STATS || CSV_PROFILER || IMGUI_TRACE_ENABLED
+			if (!IsDrawStatsEnabled())
+			{
+				Reset();
+				return;
+			}
+
+			FImGuiDrawStats DrawStats;
+			DrawStats.Gather(Context);
+			DrawStats.UploadBytes += FontAtlasUploadBytes;
+			DrawStats.Report();
+#endif
+
+#if IMGUI_TRACE_ENABLED
+			if (!IsEnabled())
+			{
+				Reset();
+				return;
+			}
+
+			const uint32 VertexCount = DrawStats.VertexCount;
+			const uint32 IndexCount = DrawStats.IndexCount;
+			const uint32 DrawCmdCount = DrawStats.DrawCmdCount;
+			const uint32 TextureSwitchCount = DrawStats.TextureSwitchCount;
+
+			const char* ContextName = (Context->ContextName[0] != 0) ? Context->ContextName : "Unnamed";
+
+			UE_TRACE_LOG(ImGui, WidgetFrame, ImGuiChannel)
+				<< WidgetFrame.Cycle(FPlatformTime::Cycles64())
+				<< WidgetFrame.FrameNumber((uint32)GFrameCounter)
+				<< WidgetFrame.ImGuiFrameCount((uint32)Context->FrameCount)
+				<< WidgetFrame.VertexCount(VertexCount)
+				<< WidgetFrame.IndexCount(IndexCount)
+				<< WidgetFrame.DrawCmdCount(DrawCmdCount)
+				<< WidgetFrame.TextureSwitchCount(TextureSwitchCount)
+				<< WidgetFrame.FontAtlasUploadCount(FontAtlasUploadCount)
+				<< WidgetFrame.WindowCount((uint32)Context->Windows.Size)
+				<< WidgetFrame.ViewportCount((uint32)Context->Viewports.Size)
+				<< WidgetFrame.NewFrameCycles(NewFrameCycles)
+				<< WidgetFrame.TickCycles(TickCycles)
+				<< WidgetFrame.RenderCycles(RenderCycles)
+				<< WidgetFrame.ContextName(ContextName, FCStringAnsi::Strlen(ContextName));
+#endif
+			Reset();
+		}
+
+		void Reset()
+		{
+			NewFrameCycles = TickCycles = RenderCycles = 0;
+			FontAtlasUploadCount = 0;
+			FontAtlasUploadBytes = 0;
+		}
+
+		uint64 NewFrameCycles = 0;
+		uint64 TickCycles = 0;
+		uint64 RenderCycles = 0;
+		uint32 FontAtlasUploadCount = 0;
+		uint64 FontAtlasUploadBytes = 0;
+	};
+
+	// adds elapsed cycles to the counter when the channel is enabled
+	struct FImGuiFrameTraceScope
+	{
+		explicit FImGuiFrameTraceScope(uint64& InCycles)
+			: Cycles(FImGuiFrameTrace::IsEnabled() ? &InCycles : nullptr)
+			, StartCycles(Cycles ? FPlatformTime::Cycles64() : 0)
+		{
+		}
+		~FImGuiFrameTraceScope()
+		{
+			if (Cycles)
+			{
+				*Cycles += FPlatformTime::Cycles64() - StartCycles;
+			}
+		}
+
+		uint64* Cycles;
+		uint64 StartCycles;
+	};
+}
@@ -1,79 +1,219 @@
 // Copyright 2024-26 Amit Kumar Mehar. All Rights Reserved.
 
+#include "RenderCommandFence.h"
+#include "Containers/RingBuffer.h"
+#include "Framework/Docking/TabManager.h"
+
+static TAutoConsoleVariable<int32> CVarMaxContextReleasesPerFrame(
+	TEXT("imgui.ContextPool.MaxReleasesPerFrame"),
+	4,
+	TEXT("Maximum number of destroyed widget contexts returned to the pool per frame, spreads the cost when many widgets close at once (0 = unlimited)."));
+
+static TAutoConsoleVariable<int32> CVarViewportWindowPoolSize(
+	TEXT("imgui.Viewports.WindowPoolSize"),
+	4,
+	TEXT("Maximum number of hidden viewport windows kept for reuse per window type and parent window (0 = windows are destroyed with their viewport)."));
+
+static TAutoConsoleVariable<bool> CVarViewportsHostPopups(
+	TEXT("imgui.Viewports.HostPopups"),
+	false,
+	TEXT("Place popups, menus and tooltips opened over a widget within the widget's rect, they are drawn in the widget's own pass instead of getting platform windows.\n")
+	TEXT("NOTE: the widget rect acts as the monitor, popups that don't fit in it are clamped (long menus scroll, large tooltips get cut) rather than spilling out into a platform window."));
+
+static TAutoConsoleVariable<int32> CVarViewportWindowPoolWarmUp(
+	TEXT("imgui.Viewports.WindowPoolWarmUp"),
+	1,
+	TEXT("Number of tooltip and popup windows created up front when a widget gets its parent window, so the first tooltips/popups don't pay for native window creation."));
+
 namespace ImGuiUtils
 {
-	class FWidgetDrawer;
-	struct FDeferredDeletionQueue
+	class FDeferredDeletionQueue
 	{
+	public:
 		FDeferredDeletionQueue()
 		{
 			UImGuiSubsystem::OnBeginImGuiFrame.AddRaw(this, &FDeferredDeletionQueue::ProcessObjects, /*bForceDestroy=*/false);
 			UImGuiSubsystem::OnShutdown.AddRaw(this, &FDeferredDeletionQueue::ProcessObjects, /*bForceDestroy=*/true);
 		}
 
-		template <typename ...Args>
-		void DeferredDeleteObjects(Args&&... InArgs)
+		// context is returned to the pool once the render thread is done with the widget drawers
+		void DeferredReleaseContext(FPooledImGuiContext&& Context)
 		{
-			(ObjectsPendingDelete.Emplace(Forward<Args>(InArgs)), ...);
+			// contexts released in the same frame share a batch (and a fence)
+			if (PendingBatches.IsEmpty() || PendingBatches.Last().FrameIndex != GFrameCounter)
+			{
+				FDeferredDeleteBatch& Batch = PendingBatches.EmplaceBack();
+				Batch.FrameIndex = GFrameCounter;
+			}
+
+			FDeferredDeleteBatch& Batch = PendingBatches.Last();
+			Batch.Contexts.Emplace(MoveTemp(Context));
+			// fence completes once everything enqueued so far (including the last paint of the drawers) has been processed
+			Batch.Fence.BeginFence();
 		}
 
 	private:
 		void ProcessObjects(bool bForceDestroy)
 		{
-			if (ObjectsPendingDelete.IsEmpty())
+			if (PendingBatches.IsEmpty())
 			{
 				return;
 			}
 
+			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Release Contexts"), STAT_ImGui_ReleaseContexts, STATGROUP_ImGui);
+
 			if (bForceDestroy)
 			{
-				FlushRenderingCommands();
+				// fences complete in order, only need to wait for the render thread to reach the last one
+				PendingBatches.Last().Fence.Wait();
 			}
 
-			while (ObjectsPendingDelete.Num())
+			const int32 MaxReleases = bForceDestroy ? MAX_int32 : CVarMaxContextReleasesPerFrame.GetValueOnGameThread();
+			int32 NumReleases = 0;
+			while (!PendingBatches.IsEmpty())
 			{
-				FDeferredDeleteObject& Object = ObjectsPendingDelete[0];
-				if (!bForceDestroy && (Object.FrameIndex > GFrameCounter))
+				FDeferredDeleteBatch& Batch = PendingBatches.First();
+				if (!bForceDestroy && !Batch.Fence.IsFenceComplete())
 				{
 					break;
 				}
 
-				if (Object.Storage.IsType<ImGuiContext*>())
+				while (!Batch.Contexts.IsEmpty())
 				{
-					ImGuiContext* Context = Object.Storage.Get<ImGuiContext*>();
-					ImGui::SetCurrentContext(Context);
+					if (MaxReleases > 0 && NumReleases >= MaxReleases)
 					{
-						ImGui::DestroyPlatformWindows();
-						ImGui::DestroyContext(Context);
+						return;
 					}
-					ImGui::SetCurrentContext(nullptr);
+
+					ContextPool.ReleaseContext(Batch.Contexts.Pop(EAllowShrinking::No), bForceDestroy);
+					++NumReleases;
 				}
 
-				ObjectsPendingDelete.RemoveAt(0, EAllowShrinking::No);
+				PendingBatches.PopFront();
 			}
 		}
 
-		struct FDeferredDeleteObject
+		struct FDeferredDeleteBatch
 		{
-			explicit FDeferredDeleteObject(TSharedPtr<FWidgetDrawer> InWidgetDrawer)
-				: Storage(TInPlaceType<TSharedPtr<FWidgetDrawer>>(), InWidgetDrawer)
-				, FrameIndex(GFrameCounter + 2)
+			TArray<FPooledImGuiContext> Contexts;
+			FRenderCommandFence Fence;
+			uint64 FrameIndex = 0;
+		};
+		TRingBuffer<FDeferredDeleteBatch> PendingBatches;
+	};
+	static FDeferredDeletionQueue DeferredDeletionQueue;
+
+	// bumped whenever slate tabs are moved around (docking, tearing off etc..), widgets re-resolve their parent window on the next paint
+	class FParentWindowTracker
+	{
+	public:
+		FParentWindowTracker()
+		{
+			UImGuiSubsystem::OnShutdown.AddRaw(this, &FParentWindowTracker::UnregisterTabEvents);
+		}
+
+		uint32 GetSerialNumber()
+		{
+			if (!bTabEventsRegistered && FSlateApplication::IsInitialized())
 			{
+				RegisterTabEvents();
 			}
-			explicit FDeferredDeleteObject(ImGuiContext* InContext)
-				: Storage(TInPlaceType<ImGuiContext*>(), InContext)
-				, FrameIndex(GFrameCounter + 2)
+			return SerialNumber;
+		}
+
+	private:
+		void RegisterTabEvents()
+		{
+			bTabEventsRegistered = true;
+
+			TSharedRef<FGlobalTabmanager> GlobalTabManager = FGlobalTabmanager::Get();
+			ActiveTabChangedHandle = GlobalTabManager->OnActiveTabChanged_Subscribe(FOnActiveTabChanged::FDelegate::CreateRaw(this, &FParentWindowTracker::OnTabChanged));
+			TabForegroundedHandle = GlobalTabManager->OnTabForegrounded_Subscribe(FOnActiveTabChanged::FDelegate::CreateRaw(this, &FParentWindowTracker::OnTabChanged));
+		}
+
+		void UnregisterTabEvents()
+		{
+			if (bTabEventsRegistered && FSlateApplication::IsInitialized())
 			{
+				TSharedRef<FGlobalTabmanager> GlobalTabManager = FGlobalTabmanager::Get();
+				GlobalTabManager->OnActiveTabChanged_Unsubscribe(ActiveTabChangedHandle);
+				GlobalTabManager->OnTabForegrounded_Unsubscribe(TabForegroundedHandle);
 			}
+			ActiveTabChangedHandle.Reset();
+			TabForegroundedHandle.Reset();
+			bTabEventsRegistered = false;
+		}
 
-			TVariant<TSharedPtr<FWidgetDrawer>, ImGuiContext*> Storage;
-			uint64 FrameIndex;
-		};
-		TArray<FDeferredDeleteObject> ObjectsPendingDelete;
+		void OnTabChanged(TSharedPtr<SDockTab> NewTab, TSharedPtr<SDockTab> OldTab)
+		{
+			++SerialNumber;
+		}
+
+		FDelegateHandle ActiveTabChangedHandle;
+		FDelegateHandle TabForegroundedHandle;
+		// starts at 1 so widgets resolve their window on the first paint
+		uint32 SerialNumber = 1;
+		bool bTabEventsRegistered = false;
 	};
-	static FDeferredDeletionQueue DeferredDeletionQueue;
+	static FParentWindowTracker ParentWindowTracker;
 
 	class SImGuiViewportWidget;
+
+	// viewport bookkeeping done once per frame for all viewports, instead of per viewport callbacks and slate calls
+	// (layouts with many viewports would register as many frame callbacks and could request focus several times a frame)
+	class FViewportWidgetManager
+	{
+	public:
+		FViewportWidgetManager()
+		{
+			UImGuiSubsystem::OnEndImGuiFrame.AddRaw(this, &FViewportWidgetManager::Tick);
+			UImGuiSubsystem::OnShutdown.AddRaw(this, &FViewportWidgetManager::Reset);
+		}
+
+		void RegisterWidget(SImGuiViewportWidget* Widget)
+		{
+			ViewportWidgets.AddUnique(Widget);
+		}
+
+		void UnregisterWidget(SImGuiViewportWidget* Widget)
+		{
+			ViewportWidgets.RemoveSingleSwap(Widget);
+		}
+
+		// focus is applied at the end of the frame, the last request wins
+		void RequestFocus(TSharedPtr<SWidget> Widget)
+		{
+			PendingFocusWidget = Widget;
+		}
+
+	private:
+		void Tick();
+
+		void Reset()
+		{
+			PendingFocusWidget.Reset();
+		}
+
+		TArray<SImGuiViewportWidget*> ViewportWidgets;
+		TWeakPtr<SWidget> PendingFocusWidget = nullptr;
+	};
+	static FViewportWidgetManager ViewportWidgetManager;
+
+	// slate window setup of a backend viewport, windows are only reused for the same setup
+	struct FViewportWindowParams
+	{
+		TWeakPtr<SWindow> ParentWindow = nullptr;
+		bool bTooltipWindow = false;
+		bool bPopupWindow = false;
+		bool bFocusWindowOnAppearing = false;
+
+		bool operator==(const FViewportWindowParams& Other) const
+		{
+			return ParentWindow == Other.ParentWindow && bTooltipWindow == Other.bTooltipWindow
+				&& bPopupWindow == Other.bPopupWindow && bFocusWindowOnAppearing == Other.bFocusWindowOnAppearing;
+		}
+	};
+
 	struct FImGuiViewportData
 	{
 		// only initialized for backend viewports
@@ -94,6 +234,12 @@ namespace ImGuiUtils
 		// kept it separate from widget logic as viewport widgets don't tick
 		bool bFocusRequested = false;
 
+		// window was reused from the pool, it won't activate itself when shown again
+		bool bActivateOnShow = false;
+
+		// setup the viewport window was created with (to return it to the pool)
+		FViewportWindowParams WindowParams{};
+
 		// handle to window closed event
 		// to cleanup ImGui viewport when Slate window is manually closed
 		FDelegateHandle OnWindowClosedHandle{};
@@ -117,7 +263,7 @@ namespace ImGuiUtils
 			m_WidgetDrawers[1] = MakeShared<ImGuiUtils::FWidgetDrawer>();
 
 #if WITH_EDITOR
-			FCoreDelegates::OnEndFrame.AddRaw(this, &SImGuiViewportWidget::UpdateWindowVisibility);
+			ViewportWidgetManager.RegisterWidget(this);
 #endif
 		}
 		virtual ~SImGuiViewportWidget()
@@ -128,7 +274,7 @@ namespace ImGuiUtils
 			m_WidgetDrawers[0] = m_WidgetDrawers[1] = nullptr;
 
 #if WITH_EDITOR
-			FCoreDelegates::OnEndFrame.RemoveAll(this);
+			ViewportWidgetManager.UnregisterWidget(this);
 #endif
 		}
 
@@ -167,7 +313,7 @@ namespace ImGuiUtils
 
 #if IMGUI_ALLOW_LOCAL_DRAWING
 			TSharedPtr<ImGuiUtils::FWidgetDrawer> WidgetDrawer = m_WidgetDrawers[WidgetDrawerToRenderThisFrame];
-			if (WidgetDrawer->HasDrawCommands())
+			if (m_bHasDrawData && WidgetDrawer->HasDrawCommands())
 			{
 				const FSlateRect DrawRect = WidgetGeometry.GetRenderBoundingRect();
 				WidgetDrawer->SetDrawRectOffset(DrawRect.GetTopLeft2f());
@@ -192,6 +338,7 @@ namespace ImGuiUtils
 			// it's unsafe to make ImGui calls during OnPaint() so cache the drawer index here
 			WidgetDrawerToRenderThisFrame = ImGui::GetFrameCount() & 0x1;
 			m_WidgetDrawers[WidgetDrawerToRenderThisFrame]->SetDrawData(DrawData, ImGui::GetTime(), FVector2f::ZeroVector);
+			m_bHasDrawData = true;
 		}
 
 		virtual FReply OnFocusReceived(const FGeometry& MyGeometry, const FFocusEvent& InFocusEvent) override
@@ -252,6 +399,7 @@ namespace ImGuiUtils
 			// NOTE: not passing through 'OnMouseButtonDown' as we would like to capture the mouse here and not the root widget
 
 			ImGuiIO& IO = RootWidget->GetImGuiContext()->IO;
+			INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 			IO.AddMouseButtonEvent(ImGuiUtils::UnrealToImGuiMouseButton(MouseEvent.GetEffectingButton()), /*down=*/true);
 
 			if (IO.WantCaptureMouse)
@@ -276,6 +424,7 @@ namespace ImGuiUtils
 			// NOTE: not passing through 'OnMouseButtonUp' as we would like to release the mouse capture here and not the root widget
 
 			ImGuiIO& IO = RootWidget->GetImGuiContext()->IO;
+			INC_DWORD_STAT(STAT_ImGui_InputEventsQueued);
 			IO.AddMouseButtonEvent(ImGuiUtils::UnrealToImGuiMouseButton(MouseEvent.GetEffectingButton()), /*down=*/false);
 
 			if (HasMouseCapture())
@@ -337,6 +486,16 @@ namespace ImGuiUtils
 		void ResetImGuiViewportData()
 		{
 			m_ImGuiViewport = nullptr;
+			m_MainViewportWidget = nullptr;
+			m_bHasDrawData = false;
+		}
+
+		// pooled widgets are rebound to a new viewport, drawers keep the previous contents until the first draw data
+		void AssignImGuiViewport(TWeakPtr<SImGuiWidgetBase> InMainViewportWidget, ImGuiViewport* InImGuiViewport)
+		{
+			m_ImGuiViewport = InImGuiViewport;
+			m_MainViewportWidget = InMainViewportWidget;
+			m_bHasDrawData = false;
 		}
 
 	private:
@@ -344,5 +503,207 @@ namespace ImGuiUtils
 		TSharedPtr<ImGuiUtils::FWidgetDrawer> m_WidgetDrawers[2];
 		TWeakPtr<SImGuiWidgetBase> m_MainViewportWidget = nullptr;
 		int32 WidgetDrawerToRenderThisFrame = 0;
+		bool m_bHasDrawData = false;
+	};
+
+	void FViewportWidgetManager::Tick()
+	{
+		DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Update Viewport Widgets"), STAT_ImGui_UpdateViewportWidgets, STATGROUP_ImGui);
+
+#if WITH_EDITOR
+		for (SImGuiViewportWidget* ViewportWidget : ViewportWidgets)
+		{
+			ViewportWidget->UpdateWindowVisibility();
+		}
+#endif
+
+		if (TSharedPtr<SWidget> FocusWidget = PendingFocusWidget.Pin())
+		{
+			FSlateApplication::Get().SetAllUserFocus(FocusWidget, EFocusCause::SetDirectly);
+		}
+		PendingFocusWidget.Reset();
+	}
+
+	// hidden viewport windows kept around for reuse, creating a native window (and its swap chain) for every tooltip/popup is expensive
+	class FViewportWindowPool
+	{
+	public:
+		FViewportWindowPool()
+		{
+			UImGuiSubsystem::OnBeginImGuiFrame.AddRaw(this, &FViewportWindowPool::ProcessWarmUps);
+			UImGuiSubsystem::OnShutdown.AddRaw(this, &FViewportWindowPool::Reset);
+		}
+
+		// returns a pooled window matching the setup (or a new one), the window is hidden until ImGui shows it
+		TSharedRef<SWindow> AcquireWindow(const FViewportWindowParams& Params, TWeakPtr<SImGuiWidgetBase> MainViewportWidget, ImGuiViewport* Viewport,
+			TSharedPtr<SImGuiViewportWidget>& OutViewportWidget, bool& bOutReused)
+		{
+			for (int32 Index = PooledWindows.Num() - 1; Index >= 0; --Index)
+			{
+				FPooledWindow& PooledWindow = PooledWindows[Index];
+				if (PooledWindow.Params == Params && PooledWindow.Window->GetNativeWindow().IsValid())
+				{
+					TSharedRef<SWindow> Window = PooledWindow.Window.ToSharedRef();
+					Window->GetOnWindowClosedEvent().Remove(PooledWindow.OnWindowClosedHandle);
+					OutViewportWidget = PooledWindow.ViewportWidget;
+					PooledWindows.RemoveAtSwap(Index);
+
+					OutViewportWidget->AssignImGuiViewport(MainViewportWidget, Viewport);
+					Window->SetOpacity(1.f);
+					bOutReused = true;
+					return Window;
+				}
+			}
+
+			OutViewportWidget = SNew(SImGuiViewportWidget, MainViewportWidget, Viewport);
+			bOutReused = false;
+			return CreateWindow(Params, OutViewportWidget.ToSharedRef());
+		}
+
+		// hides the window and keeps it for the next viewport with the same setup, returns false if the window should be destroyed
+		bool ReleaseWindow(const TSharedRef<SWindow>& Window, const TSharedPtr<SImGuiViewportWidget>& ViewportWidget, const FViewportWindowParams& Params)
+		{
+			if (!ViewportWidget || !Params.ParentWindow.IsValid() || !Window->GetNativeWindow().IsValid()
+				|| GetNumPooledWindows(Params) >= CVarViewportWindowPoolSize.GetValueOnGameThread())
+			{
+				return false;
+			}
+
+			Window->HideWindow();
+			AddPooledWindow(Window, ViewportWidget.ToSharedRef(), Params);
+			return true;
+		}
+
+		// tooltip/popup windows for the parent are created at the start of the next frame (not while painting)
+		void RequestWarmUp(TWeakPtr<SWindow> ParentWindow)
+		{
+			if (ParentWindow.IsValid() && CVarViewportWindowPoolWarmUp.GetValueOnGameThread() > 0)
+			{
+				PendingWarmUps.AddUnique(ParentWindow);
+			}
+		}
+
+	private:
+		struct FPooledWindow
+		{
+			TSharedPtr<SWindow> Window = nullptr;
+			TSharedPtr<SImGuiViewportWidget> ViewportWidget = nullptr;
+			FViewportWindowParams Params{};
+			FDelegateHandle OnWindowClosedHandle{};
+		};
+
+		static TSharedRef<SWindow> CreateWindow(const FViewportWindowParams& Params, TSharedRef<SImGuiViewportWidget> ViewportWidget)
+		{
+			TSharedRef<SWindow> Window =
+				SNew(SWindow)
+				.MinWidth(0.f)
+				.MinHeight(0.f)
+				.LayoutBorder({ 0 })
+				.SizingRule(ESizingRule::FixedSize)
+				.UserResizeBorder(FMargin(0))
+				.HasCloseButton(false)
+				.CreateTitleBar(false)
+				.IsPopupWindow(Params.bPopupWindow)
+				.IsTopmostWindow(Params.bTooltipWindow)
+				.Type(Params.bTooltipWindow ? EWindowType::ToolTip : (Params.bPopupWindow ? EWindowType::Menu : EWindowType::Normal))
+				.UseOSWindowBorder(false)
+				.FocusWhenFirstShown(Params.bFocusWindowOnAppearing)
+				.ActivationPolicy(Params.bFocusWindowOnAppearing ? EWindowActivationPolicy::Always : EWindowActivationPolicy::Never)
+				.Content()
+				[
+					ViewportWidget
+				];
+
+			// native window (and viewport) are created here, ImGui shows the window once its position/size are set
+			if (TSharedPtr<SWindow> ParentWindow = Params.ParentWindow.Pin())
+			{
+				FSlateApplication::Get().AddWindowAsNativeChild(Window, ParentWindow.ToSharedRef(), /*bShowImmediately=*/false);
+			}
+			else
+			{
+				FSlateApplication::Get().AddWindow(Window, /*bShowImmediately=*/false);
+			}
+			return Window;
+		}
+
+		void AddPooledWindow(const TSharedRef<SWindow>& Window, const TSharedRef<SImGuiViewportWidget>& ViewportWidget, const FViewportWindowParams& Params)
+		{
+			FPooledWindow& PooledWindow = PooledWindows.AddDefaulted_GetRef();
+			PooledWindow.Window = Window;
+			PooledWindow.ViewportWidget = ViewportWidget;
+			PooledWindow.Params = Params;
+			// pooled windows go away along with their parent window
+			PooledWindow.OnWindowClosedHandle = Window->GetOnWindowClosedEvent().AddRaw(this, &FViewportWindowPool::OnPooledWindowClosed);
+		}
+
+		int32 GetNumPooledWindows(const FViewportWindowParams& Params) const
+		{
+			int32 NumWindows = 0;
+			for (const FPooledWindow& PooledWindow : PooledWindows)
+			{
+				NumWindows += (PooledWindow.Params == Params) ? 1 : 0;
+			}
+			return NumWindows;
+		}
+
+		void OnPooledWindowClosed(const TSharedRef<SWindow>& Window)
+		{
+			PooledWindows.RemoveAllSwap([&Window](const FPooledWindow& PooledWindow) { return PooledWindow.Window == Window; });
+		}
+
+		void ProcessWarmUps()
+		{
+			if (PendingWarmUps.IsEmpty())
+			{
+				return;
+			}
+
+			DECLARE_SCOPE_CYCLE_COUNTER(TEXT("Warm Up Viewport Windows"), STAT_ImGui_WarmUpViewportWindows, STATGROUP_ImGui);
+
+			const int32 NumWarmUpWindows = FMath::Min(CVarViewportWindowPoolWarmUp.GetValueOnGameThread(), CVarViewportWindowPoolSize.GetValueOnGameThread());
+			for (const TWeakPtr<SWindow>& ParentWindow : PendingWarmUps)
+			{
+				if (!ParentWindow.IsValid())
+				{
+					continue;
+				}
+
+				// tooltips and popups are the windows created (and destroyed) all the time
+				for (const bool bTooltipWindow : { true, false })
+				{
+					FViewportWindowParams Params;
+					Params.ParentWindow = ParentWindow;
+					Params.bTooltipWindow = bTooltipWindow;
+					Params.bPopupWindow = true;
+					Params.bFocusWindowOnAppearing = false;
+
+					for (int32 Index = GetNumPooledWindows(Params); Index < NumWarmUpWindows; ++Index)
+					{
+						TSharedRef<SImGuiViewportWidget> ViewportWidget = SNew(SImGuiViewportWidget, nullptr, nullptr);
+						AddPooledWindow(CreateWindow(Params, ViewportWidget), ViewportWidget, Params);
+					}
+				}
+			}
+			PendingWarmUps.Reset();
+		}
+
+		void Reset()
+		{
+			PendingWarmUps.Reset();
+
+			TArray<FPooledWindow> Windows = MoveTemp(PooledWindows);
+			for (FPooledWindow& PooledWindow : Windows)
+			{
+				PooledWindow.Window->GetOnWindowClosedEvent().Remove(PooledWindow.OnWindowClosedHandle);
+				if (FSlateApplication::IsInitialized())
+				{
+					PooledWindow.Window->RequestDestroyWindow();
+				}
+			}
+		}
+
+		TArray<FPooledWindow> PooledWindows;
+		TArray<TWeakPtr<SWindow>> PendingWarmUps;
 	};
+	static FViewportWindowPool ViewportWindowPool;
 }
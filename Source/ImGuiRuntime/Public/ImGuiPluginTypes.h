@@ -13,12 +13,75 @@
 
 #include "implot/implot.h"
 
+// memory categories used for LLM tags and per context accounting (see `imgui.Memory.Dump`)
+enum class EImGuiMemoryCategory : uint8
+{
+	Core,
+	DrawLists,
+	FontAtlas,
+	ImPlot,
+	NetImgui,
+	Snapshots,
+	Count
+};
+
+namespace ImGuiMemory
+{
+	// `UserData` points to the calling module's current context pointer (`GImGui`) so allocations can be attributed to the active context
+	IMGUIRUNTIME_API void* Malloc(size_t Size, void* UserData);
+	IMGUIRUNTIME_API void Free(void* Pointer, void* UserData);
+
+	// returns previous category for the calling thread
+	IMGUIRUNTIME_API EImGuiMemoryCategory SetCurrentCategory(EImGuiMemoryCategory Category);
+	// moves remaining allocations of a destroyed context to the unowned bucket
+	IMGUIRUNTIME_API void OnContextDestroyed(const ImGuiContext* Context);
+
+	// routes game thread allocations into the current context's frame arena (see `FImGuiTransientMemoryScope`), returns previous state
+	IMGUIRUNTIME_API bool SetTransientAllocations(bool bEnable);
+	// recycles the context's frame arena, called before ImGui::NewFrame
+	IMGUIRUNTIME_API void ResetFrameArena(const ImGuiContext* Context);
+	// total number of heap allocations made through the ImGui allocator (excludes frame arena allocations)
+	IMGUIRUNTIME_API uint64 GetHeapAllocationCount();
+}
+
+// opt-in cache of text sizes and glyph quads keyed by font, font size and string hash (see `imgui.TextCache.Report`)
+// meant for labels drawn every frame, entries that aren't used for a few frames are dropped
+// NOTE: game thread only
+namespace ImGuiTextCache
+{
+	// same as ImGui::CalcTextSize (without wrapping) using the current font
+	IMGUIRUNTIME_API ImVec2 CalcTextSize(const char* Text, const char* TextEnd = nullptr, bool bHideTextAfterDoubleHash = false);
+	// same as ImDrawList::AddText using the draw list's current font, cached glyph quads are copied and moved to `Pos`
+	IMGUIRUNTIME_API void AddText(ImDrawList* DrawList, const ImVec2& Pos, ImU32 Color, const char* Text, const char* TextEnd = nullptr);
+	// same as ImGui::TextUnformatted for single line text
+	IMGUIRUNTIME_API void TextUnformatted(const char* Text, const char* TextEnd = nullptr);
+	// drops all entries, called when fonts are destroyed
+	IMGUIRUNTIME_API void Reset();
+}
+
+// rounded rects, circles and lines drawn as a single quad each, coverage is evaluated analytically in the pixel shader
+// draw them between BeginShapes/EndShapes (other draw list calls in between are not supported), falls back to ImDrawList tessellation
+// when the renderer can't draw them (`imgui.Shapes.Enable`) or the shape is too large to pack (half size above 2047 px)
+// NOTE: game thread only
+namespace ImGuiShapes
+{
+	IMGUIRUNTIME_API void BeginShapes(ImDrawList* DrawList);
+	IMGUIRUNTIME_API void EndShapes(ImDrawList* DrawList);
+
+	// same as the ImDrawList functions (all corners rounded, circles without a segment count)
+	IMGUIRUNTIME_API void AddRectFilled(ImDrawList* DrawList, const ImVec2& Min, const ImVec2& Max, ImU32 Color, float Rounding = 0.f);
+	IMGUIRUNTIME_API void AddRect(ImDrawList* DrawList, const ImVec2& Min, const ImVec2& Max, ImU32 Color, float Rounding = 0.f, float Thickness = 1.f);
+	IMGUIRUNTIME_API void AddCircleFilled(ImDrawList* DrawList, const ImVec2& Center, float Radius, ImU32 Color);
+	IMGUIRUNTIME_API void AddCircle(ImDrawList* DrawList, const ImVec2& Center, float Radius, ImU32 Color, float Thickness = 1.f);
+	IMGUIRUNTIME_API void AddLine(ImDrawList* DrawList, const ImVec2& P1, const ImVec2& P2, ImU32 Color, float Thickness = 1.f);
+}
+
 // since the module is built as DLL, we need to register allocators for each module that makes ImGui calls, usually at module startup
 #define IMGUI_SETUP_DEFAULT_ALLOCATOR()                                                         \
 	ImGui::SetAllocatorFunctions(                                                               \
-	/*Alloc*/    [](size_t Size, void* UserData = nullptr) { return FMemory::Malloc(Size); },   \
-	/*Free*/     [](void* Pointer, void* UserData = nullptr) { FMemory::Free(Pointer); },       \
-	/*UserData*/ nullptr);
+	/*Alloc*/    &ImGuiMemory::Malloc,                                                          \
+	/*Free*/     &ImGuiMemory::Free,                                                            \
+	/*UserData*/ &GImGui);
 
 #define IMGUI_FNAME(Name) [](){ static FName StaticFName(Name); return StaticFName; }()
 
@@ -54,6 +117,40 @@ struct FImGuiTickContext
 	// allow callback to modify enabled state (alternative to UImGuiSubsystem::GetMainMenuWidgetActiveState(...))
 	bool* MainMenuBar_CurrentItemEnabledState = nullptr;
 
+	// time budget for the widget currently ticking, heavy work can be spread over multiple frames using `FImGuiTimeSlicedIterator`
+	// main menu widgets share a global budget (imgui.FrameBudget.MainMenuMs) so the per widget budget can shrink when the menu is busy
+	double FrameBudget_StartTime = 0.0;
+	double FrameBudget_Seconds = TNumericLimits<double>::Max();
+
+	void BeginFrameBudget(double BudgetSeconds)
+	{
+		FrameBudget_StartTime = FPlatformTime::Seconds();
+		FrameBudget_Seconds = BudgetSeconds;
+	}
+
+	// returns the time spent since BeginFrameBudget, code running afterwards is no longer budgeted
+	double EndFrameBudget()
+	{
+		const double ElapsedSeconds = GetElapsedFrameBudget();
+		FrameBudget_Seconds = TNumericLimits<double>::Max();
+		return ElapsedSeconds;
+	}
+
+	double GetElapsedFrameBudget() const
+	{
+		return FPlatformTime::Seconds() - FrameBudget_StartTime;
+	}
+
+	double GetRemainingFrameBudget() const
+	{
+		return FMath::Max(0.0, FrameBudget_Seconds - GetElapsedFrameBudget());
+	}
+
+	bool IsOverFrameBudget() const
+	{
+		return GetElapsedFrameBudget() >= FrameBudget_Seconds;
+	}
+
 	// this is different from `AllocateSpaceForRightAlignedMenuWidget` as ImGui::BeginMenu has some custom logic to handle item spacing
 	bool AllocateSpaceForRightAlignedMenuItem(const char* Label)
 	{
@@ -64,7 +161,7 @@ struct FImGuiTickContext
 
 		const float ItemSpacing = ImGui::GetStyle().ItemSpacing.x;
 
-		float LabelSize = ImGui::CalcTextSize(Label, ImGui::FindRenderedTextEnd(Label), false).x;
+		float LabelSize = ImGuiTextCache::CalcTextSize(Label, nullptr, /*bHideTextAfterDoubleHash=*/true).x;
 		LabelSize += ItemSpacing * 2.f - 1.f;
 		if (MainMenuBar_RightDirCursorPosX - LabelSize > MainMenuBar_RightDirOffsetX)
 		{
@@ -119,6 +216,66 @@ struct FImGuiTickContext
 	}
 };
 
+/**
+ * Resumable loop for spreading heavy work over multiple frames, keep the iterator around b/w ticks.
+ * Processes items until the widget runs out of frame budget and continues from the same item next frame.
+ *
+ *	static FImGuiTimeSlicedIterator ActorIterator;
+ *	if (ActorIterator.Run(Context, Actors.Num(), [&](int32 ActorIndex) { GatherActorStats(Actors[ActorIndex]); }))
+ *	{
+ *		// completed a full pass over the actors
+ *	}
+ */
+struct FImGuiTimeSlicedIterator
+{
+	// returns true once the last item is processed, the next call starts over from the first item
+	// atleast `ItemsPerBudgetCheck` items are processed per call to guarantee progress
+	template <typename ItemCallback>
+	bool Run(const FImGuiTickContext* Context, int32 NumItems, ItemCallback&& Callback, int32 ItemsPerBudgetCheck = 16)
+	{
+		if (NextIndex >= NumItems)
+		{
+			NextIndex = 0;
+		}
+
+		int32 ItemsSinceBudgetCheck = 0;
+		while (NextIndex < NumItems)
+		{
+			Callback(NextIndex++);
+
+			if (++ItemsSinceBudgetCheck >= ItemsPerBudgetCheck)
+			{
+				ItemsSinceBudgetCheck = 0;
+				if (Context && Context->IsOverFrameBudget())
+				{
+					break;
+				}
+			}
+		}
+
+		if (NextIndex >= NumItems)
+		{
+			NextIndex = 0;
+			++NumCompletedPasses;
+			return true;
+		}
+		return false;
+	}
+
+	void Reset()
+	{
+		NextIndex = 0;
+	}
+
+	float GetProgress(int32 NumItems) const
+	{
+		return (NumItems > 0) ? FMath::Clamp((float)NextIndex / NumItems, 0.f, 1.f) : 1.f;
+	}
+
+	int32 NextIndex = 0;
+	int32 NumCompletedPasses = 0;
+};
+
 // since modules can be added as DLL, we need to set context before making ImGui calls.
 struct FImGuiTickScope : FNoncopyable
 {
@@ -161,6 +318,37 @@ struct FImGuiTickScope : FNoncopyable
 	bool bRestoreContext = false;
 };
 
+// tags ImGui allocations made on this thread with a memory category
+struct FImGuiMemoryScope final : FNoncopyable
+{
+	explicit FImGuiMemoryScope(EImGuiMemoryCategory Category)
+		: PrevCategory(ImGuiMemory::SetCurrentCategory(Category))
+	{
+	}
+	~FImGuiMemoryScope()
+	{
+		ImGuiMemory::SetCurrentCategory(PrevCategory);
+	}
+
+	EImGuiMemoryCategory PrevCategory;
+};
+
+// allocations made in this scope come from a per context bump allocator which is recycled at the start of the next frame
+// NOTE: only use for data that doesn't outlive the current frame (temporary ImVector/ImGuiTextBuffer, formatting etc..)
+struct FImGuiTransientMemoryScope final : FNoncopyable
+{
+	FImGuiTransientMemoryScope()
+		: bPrevState(ImGuiMemory::SetTransientAllocations(true))
+	{
+	}
+	~FImGuiTransientMemoryScope()
+	{
+		ImGuiMemory::SetTransientAllocations(bPrevState);
+	}
+
+	bool bPrevState;
+};
+
 // scope to resolve label/name conflicts
 struct FImGuiNamedScope final : FNoncopyable
 {
@@ -287,6 +475,7 @@ namespace FImGui
 #define ImDrawCallback_SetShaderState		 (ImDrawCallback)(-2)
 #define ImDrawCallback_SetSamplerStatePoint	 (ImDrawCallback)(-3)
 #define ImDrawCallback_ResetSamplerState	 (ImDrawCallback)(-4)
+#define ImDrawCallback_SetShapeRendering	 (ImDrawCallback)(-5) // UserCallbackData != nullptr to enable, see ImGuiShapes
 using FImGuiShaderState = void*;
 
 enum class EImGuiShaderState : uint32
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Tasks/Task.h"
 #include "ImGuiPluginTypes.h"
 #include "UObject/GCObject.h"
 #include "Styling/SlateBrush.h"
@@ -20,6 +21,10 @@ class FSlateShaderResourceProxy;
 namespace ImGuiUtils
 {
 	class FImGuiImageCache;
+	class FImGuiFileWriter;
+	class FImGuiFontData;
+	class FImGuiGlyphBaker;
+	class FImGuiGlyphCache;
 }
 
 DECLARE_STATS_GROUP(TEXT("ImGui"), STATGROUP_ImGui, STATCAT_Advanced);
@@ -65,6 +70,8 @@ public:
 
 	// initialization
 	IMGUIRUNTIME_API static UImGuiSubsystem* Get();
+	// same as Get, logs to `Ar` when the subsystem isn't initialized (console commands)
+	static UImGuiSubsystem* Get(FOutputDevice& Ar);
 	IMGUIRUNTIME_API static bool ShouldEnableImGui();
 	static void InitializeSubsystemInstance();
 	static void ReleaseSubsystemInstance();
@@ -85,6 +92,11 @@ public:
 	FConfigFile* GetSaveDataConfigFile() const { return m_SaveDataConfigFile; }
 	IMGUIRUNTIME_API bool SaveConfigToDisk() const;
 
+	// ini/save data files are written on a background task, repeated writes to the same file are coalesced
+	void QueueFileWrite(const FString& FilePath, TArray<uint8>&& Contents) const;
+	// contents queued for a file that haven't been written yet
+	bool GetPendingFileContents(const FString& FilePath, TArray<uint8>& OutContents) const;
+
 	// resources
 	IMGUIRUNTIME_API FImGuiImageBindingParams RegisterOneFrameResource(const FSlateBrush* SlateBrush, FVector2f LocalSize, float DrawScale = 1.f);
 	FImGuiImageBindingParams RegisterOneFrameResource(const FSlateBrush* SlateBrush, float UniformSize) { return RegisterOneFrameResource(SlateBrush, FVector2f(UniformSize)); }
@@ -116,7 +128,21 @@ public:
 	void UpdateFontAtlasTextures(ImTextureData** Textures, int32 TextureCount);
 	IMGUIRUNTIME_API void CommitSharedFontAtlasChanges();
 	IMGUIRUNTIME_API ImTextureRef GetSharedFontTextureID() const;
-	ImFontAtlas* GetSharedFontAtlas() const { return m_SharedFontAtlas.Get(); }
+	// loads the default fonts first (see EnsureFontsLoaded), fonts added by client code never replace Fonts[0]
+	ImFontAtlas* GetSharedFontAtlas() { EnsureFontsLoaded(); return m_SharedFontAtlas.Get(); }
+
+	// default font baked once as a signed distance field (`imgui.Fonts.SDF`), lives in its own atlas which contexts have to register
+	ImFont* GetSdfFont() const { return m_SdfFont; }
+	bool IsSdfFontTexture(int32 TextureIndex) const { return m_SharedFontAtlasTextures.IsValidIndex(TextureIndex) && m_SharedFontAtlasTextures[TextureIndex].bIsSdf; }
+
+	// with `imgui.LazyInitialization` fonts are loaded when the first widget is created
+	IMGUIRUNTIME_API void EnsureFontsLoaded();
+	bool AreFontsLoaded() const { return m_bFontsLoaded; }
+	void ReportStartupTimings(FOutputDevice& Ar) const;
+
+	// adds a font to the shared font atlas, the file is memory mapped (when supported) and referenced by the atlas instead of being copied
+	IMGUIRUNTIME_API ImFont* AddFontFromFile(const FString& FilePath, float SizePixels, const ImFontConfig* FontConfig = nullptr, const ImWchar* GlyphRanges = nullptr);
+	void ReportFontData(FOutputDevice& Ar) const;
 
 	bool CaptureGpuFrame() const;
 
@@ -128,10 +154,14 @@ private:
 	int32 AllocateFontAtlasTexture(int32 SizeX, int32 SizeY);
 	void ReleaseFontAtlasTexture(int32 Index);
 
+	ImFont* AddFontData(TUniquePtr<ImGuiUtils::FImGuiFontData> FontData, float SizePixels, const ImFontConfig* FontConfig, const ImWchar* GlyphRanges);
+	void AddSdfFont(const ImGuiUtils::FImGuiFontData& FontData, float SizePixels);
+
 private:
 	static TUniquePtr<UImGuiSubsystem> SubsystemInstance;
 
 	FConfigFile* m_SaveDataConfigFile = nullptr;
+	TUniquePtr<ImGuiUtils::FImGuiFileWriter> m_FileWriter;
 
 	FAnsiString m_IniDirectoryPath;
 
@@ -143,12 +173,30 @@ private:
 		TObjectPtr<UTextureRenderTarget2D> BrushTexture = nullptr;
 #endif
 		bool bInUse = false;
+		// texture of the SDF font atlas, drawn with the SDF pixel shader
+		bool bIsSdf = false;
 	};
 	TArray<FImGuiFontTextureEntry> m_SharedFontAtlasTextures;
 
 	int32 m_FontAtlasBuilderFrameCount = 0;
 	TSharedPtr<ImFontAtlas, ESPMode::NotThreadSafe> m_SharedFontAtlas;
 	TUniquePtr<ImGuiUtils::FImGuiImageCache> m_ImageCache;
+	TSharedPtr<ImFontAtlas, ESPMode::NotThreadSafe> m_SdfFontAtlas;
+	ImFont* m_SdfFont = nullptr;
+	TUniquePtr<ImGuiUtils::FImGuiGlyphBaker> m_GlyphBaker;
+	// glyphs rasterized in previous sessions, loaded on a background task during startup
+	TUniquePtr<ImGuiUtils::FImGuiGlyphCache> m_GlyphCache;
+	UE::Tasks::FTask m_GlyphCacheLoadTask;
+
+	// default font file is mapped on a background task during startup
+	UE::Tasks::TTask<TUniquePtr<ImGuiUtils::FImGuiFontData>> m_DefaultFontDataTask;
+	// data referenced by the shared font atlas, has to outlive it
+	TArray<TUniquePtr<ImGuiUtils::FImGuiFontData>> m_FontData;
+	bool m_bFontsLoaded = false;
+
+	// startup cost, see `imgui.Startup.Report`
+	double m_InitializeTime = 0.0;
+	double m_FontLoadTime = 0.0;
 
 	TArray<FSlateBrush> m_OneFrameSlateBrushes;
 	TArray<FImGuiTextureResource> m_OneFrameResources;
@@ -15,6 +15,7 @@ struct FImGuiTickContext;
 namespace ImGuiUtils
 {
 	class FWidgetDrawer;
+	struct FImGuiFrameTrace;
 }
 
 class IMGUIRUNTIME_API SImGuiWidgetBase : public SLeafWidget
@@ -83,6 +84,10 @@ public:
 	uint64 GetLastPaintFrameCounter() const { return m_LastPaintFrameCounter; }
 #endif
 
+	// resolves the window hosting the main viewport (parents the viewport windows), called on paint
+	// returns whether the widget path was walked, the result is cached until tabs move or the widget is painted into another window
+	bool UpdateParentWindow(const SWindow* PaintWindow) const;
+
 protected:
 	// Helper functions for manually ticking ImGui logic
 	// setup work for ImGui::NewFrame
@@ -90,9 +95,18 @@ protected:
 	// to ensure ImGui::EndFrame is called (for cases when widget is not rendered)
 	void EndImGuiFrame();
 
+	// time budget for a single widget tick (imgui.FrameBudget.WidgetMs)
+	static double GetWidgetFrameBudgetSeconds();
+
 private:
 	FORCEINLINE void AddKeyEvent(ImGuiIO& IO, FKeyEvent KeyEvent, bool IsDown);
 
+	// submits the latest gamepad axis values received since the last frame
+	void FlushAnalogEvents(ImGuiIO& IO);
+
+	// serializes the ini settings of the current context and hands them to the subsystem file writer
+	void QueueIniSettingsSave();
+
 	virtual void TickImGuiInternal(FImGuiTickContext* TickContext) = 0;
 
 private:
@@ -103,9 +117,29 @@ private:
 	FAnsiString m_ConfigFilePath;
 	TSharedPtr<ImGuiUtils::FWidgetDrawer> m_WidgetDrawers[2];
 
+	// per frame stats for the "ImGui" trace channel
+	TUniquePtr<ImGuiUtils::FImGuiFrameTrace> m_FrameTrace;
+
+	// monitor list version applied to the platform io
+	uint32 m_MonitorSerialNumber = 0;
+
+	// widget rect published as a monitor (imgui.Viewports.HostPopups), popups are placed and clamped within it instead of getting platform windows
+	FSlateRect m_HostMonitorRect{};
+
+	// parent window is only looked up again when tabs move or we get painted into a different window
+	mutable uint32 m_ParentWindowSerialNumber = 0;
+	mutable const SWindow* m_LastPaintWindow = nullptr;
+
 	// initial zoom support
 	float m_WindowScale = 1.f;
 
+	// default font while drawing locally (`imgui.Fonts.SDF`), frames drawn by NetImgui fall back to the shared atlas font
+	ImFont* m_SdfFont = nullptr;
+
+	// gamepad axis values batched per frame (indexed by ImGuiUtils::EGamepadAxis)
+	float m_PendingAnalogValues[8] = {};
+	uint32 m_PendingAnalogAxes = 0;
+
 	mutable uint8 m_CachedImGuiCursor = 0;
 	bool m_IsDragOverActive = false;
 	TSharedPtr<class FDragDropOperation> LastDragDropOperation;
@@ -4,6 +4,7 @@
 
 #include "Shader.h"
 #include "GlobalShader.h"
+#include "ShaderPermutation.h"
 #include "ShaderParameterUtils.h"
 #include "ShaderParameterStruct.h"
 
@@ -12,17 +13,27 @@ class IMGUISHADERS_API FImGuiVS : public FGlobalShader
 	DECLARE_SHADER_TYPE(FImGuiVS, Global);
 
 public:
+	// no vertex input, glyph quads are expanded from instances (see FImGuiGlyphInstances)
+	class FGlyphInstances : SHADER_PERMUTATION_BOOL("IMGUI_GLYPH_INSTANCES");
+	// shape params are unpacked from the vertex UVs (see ImGuiShapes)
+	class FSdfShapes : SHADER_PERMUTATION_BOOL("IMGUI_SDF_SHAPES");
+	using FPermutationDomain = TShaderPermutationDomain<FGlyphInstances, FSdfShapes>;
+
 	FImGuiVS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
 		: FGlobalShader(Initializer)
 	{
 		ProjectionMatrixParam.Bind(Initializer.ParameterMap, TEXT("ProjectionMatrix"));
 		TexCoordOverrideModeParam.Bind(Initializer.ParameterMap, TEXT("TexCoordOverrideMode"));
+		GlyphInstancesParam.Bind(Initializer.ParameterMap, TEXT("GlyphInstances"));
+		GlyphRectsParam.Bind(Initializer.ParameterMap, TEXT("GlyphRects"));
+		GlyphInstanceOffsetParam.Bind(Initializer.ParameterMap, TEXT("GlyphInstanceOffset"));
 	}
 	FImGuiVS() {}
 
 	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
 	{
-		return true;
+		const FPermutationDomain PermutationVector(Parameters.PermutationId);
+		return !(PermutationVector.Get<FGlyphInstances>() && PermutationVector.Get<FSdfShapes>());
 	}
 
 	void SetParameters(
@@ -34,9 +45,26 @@ public:
 		SetShaderValue(BatchedParameters, TexCoordOverrideModeParam, TexCoordOverrideMode);
 	}
 
+	void SetParameters(
+		FRHIBatchedShaderParameters& BatchedParameters,
+		const FMatrix44f& ProjectionMatrix,
+		const FUintVector2& TexCoordOverrideMode,
+		FRHIShaderResourceView* GlyphInstances,
+		FRHIShaderResourceView* GlyphRects,
+		uint32 GlyphInstanceOffset)
+	{
+		SetParameters(BatchedParameters, ProjectionMatrix, TexCoordOverrideMode);
+		SetSRVParameter(BatchedParameters, GlyphInstancesParam, GlyphInstances);
+		SetSRVParameter(BatchedParameters, GlyphRectsParam, GlyphRects);
+		SetShaderValue(BatchedParameters, GlyphInstanceOffsetParam, GlyphInstanceOffset);
+	}
+
 private:
 	LAYOUT_FIELD(FShaderParameter, ProjectionMatrixParam);
 	LAYOUT_FIELD(FShaderParameter, TexCoordOverrideModeParam);
+	LAYOUT_FIELD(FShaderResourceParameter, GlyphInstancesParam);
+	LAYOUT_FIELD(FShaderResourceParameter, GlyphRectsParam);
+	LAYOUT_FIELD(FShaderParameter, GlyphInstanceOffsetParam);
 };
 
 class IMGUISHADERS_API FImGuiPS : public FGlobalShader
@@ -44,6 +72,12 @@ class IMGUISHADERS_API FImGuiPS : public FGlobalShader
 	DECLARE_SHADER_TYPE(FImGuiPS, Global);
 
 public:
+	// texture alpha is a signed distance field (SDF font atlas)
+	class FSdfFont : SHADER_PERMUTATION_BOOL("IMGUI_SDF_FONT");
+	// coverage of rounded rects/circles/lines evaluated from the shape params, texture is not sampled
+	class FSdfShapes : SHADER_PERMUTATION_BOOL("IMGUI_SDF_SHAPES");
+	using FPermutationDomain = TShaderPermutationDomain<FSdfFont, FSdfShapes>;
+
 	FImGuiPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
 		: FGlobalShader(Initializer)
 	{
@@ -55,7 +89,8 @@ public:
 
 	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
 	{
-		return true;
+		const FPermutationDomain PermutationVector(Parameters.PermutationId);
+		return !(PermutationVector.Get<FSdfFont>() && PermutationVector.Get<FSdfShapes>());
 	}
 
 	void SetParameters(